@@ -8,6 +8,11 @@
 #include <process.h>
 #include <types.h>
 
+/**
+ * The seed of randomized schedulers unless specified otherwise.
+ */
+#define CONFIG_SEED_DEFAULT 1
+
 typedef struct Config Config;
 
 /**
@@ -24,11 +29,16 @@ extern ulong lineno;
  * will contain the line within the configuration file the load operation
  * read up to.
  *
- * @param  dest Will be updated to point at the new configuration object
- * @param  cf   The configuration file to deserialize
- * @return      True if loading succeeded
+ * When streaming, only the header of the configuration file is read and the
+ * file is left positioned at the first process, so that processes can be read
+ * on demand (see source_stream()). No process list is created in that case.
+ *
+ * @param  dest   Will be updated to point at the new configuration object
+ * @param  cf     The configuration file to deserialize
+ * @param  stream True if processes should be left unread
+ * @return        True if loading succeeded
  */
-bool config_load(Config **dest, FILE *cf);
+bool config_load(Config **dest, FILE *cf, bool stream);
 
 /**
  * Frees all memory associated with a configuration object.
@@ -50,17 +60,51 @@ SchedulerType config_use(Config *config);
 uint config_runfor(Config *config);
 
 /**
- * This is only relevant in the context of the Round-Robin scheduling
- * algorithm. This value should be disregarded in all other contexts.
+ * This is only relevant in the context of schedulers configured with a
+ * quantum: the Round-Robin, stride and lottery schedulers (see
+ * scheduler_quantum()). This value should be disregarded in all other
+ * contexts.
  *
  * @param  config A pointer to a configuration object
  * @return        The maximum amount of time alloted to each running process
  */
 uint config_quantum(Config *config);
 
+/**
+ * This is only relevant in the context of randomized scheduling algorithms,
+ * such as the lottery scheduler.
+ *
+ * @param  config A pointer to a configuration object
+ * @return        The seed of the random number generator
+ */
+uint config_seed(Config *config);
+
+/**
+ * @param  config A pointer to a configuration object
+ * @return        The number of ticks of overhead charged for every context
+ *                switch
+ */
+uint config_switchcost(Config *config);
+
+/**
+ * This is only relevant in the context of schedulers that age waiting
+ * processes, such as the priority scheduler.
+ *
+ * @param  config A pointer to a configuration object
+ * @return        The number of ticks a process must wait for its priority to
+ *                rise by one level, or 0 if processes don't age
+ */
+uint config_aging(Config *config);
+
+/**
+ * @param  config A pointer to a configuration object
+ * @return        The number of processes declared by the configuration
+ */
+size_t config_processcount(Config *config);
+
 /**
  * @param  config A pointer to a configuration object
- * @return        A pointer to a list of processes
+ * @return        A pointer to a list of processes, or NULL when streaming
  */
 ProcessList *config_processes(Config *config);
 
@@ -0,0 +1,524 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <stdbool.h>
+#include <output.h>
+#include <process.h>
+#include <progress.h>
+#include <report.h>
+#include <source.h>
+#include <timeline.h>
+#include <types.h>
+#include <wheel.h>
+
+/**
+ * Forces a function to be inlined into its caller. The simulation loop is
+ * declared this way so that it can be stamped out once per policy and trace
+ * setting, letting the compiler resolve every policy hook to a direct (and
+ * usually inlined) call and fold away every branch on the trace flag.
+ */
+#define engine_inline static inline __attribute__((always_inline))
+
+// #region Job -----------------------------------------------------------------
+
+typedef struct Job
+{
+    Process *process;
+    const char *name;
+    size_t seq;        // position in order of arrival
+    uint start;        // arrival time
+    uint length;       // total current CPU burst
+    uint burst;        // remaining burst, as of being dispatched if running
+    uint dispatched;   // time the remaining burst was last brought up to date
+    uint since;        // time the job's current run started (or will start)
+    uint ran;          // ticks of completed CPU bursts
+    uint served;       // ticks of completed CPU and I/O bursts
+    uint blocked;      // time the job last blocked on I/O
+    size_t cycle;      // next cycle of I/O and CPU bursts
+    Timer timer;       // completion or expiry of the job's slice or I/O burst
+    ulong key;         // free for the policy to order jobs by
+    size_t slot;       // free for the policy to index jobs by
+    struct Job *prev;  // ready or blocked jobs
+    struct Job *next;
+} Job;
+
+/**
+ * Brings the remaining burst of a running job up to date. A job makes no
+ * progress while the context switch to it is under way.
+ *
+ * @param job  A pointer to the running job
+ * @param tick The current time
+ */
+engine_inline void job_sync(Job *job, uint tick)
+{
+    if (tick > job->dispatched) {
+        job->burst -= tick - job->dispatched;
+        job->dispatched = tick;
+    }
+}
+
+// #endregion ------------------------------------------------------------------
+
+// #region Engine --------------------------------------------------------------
+
+/**
+ * The state of a simulation shared by every policy. Jobs that are ready to
+ * run (including the running job) are kept in the order they became ready,
+ * which is their order of arrival unless they have blocked on I/O. Jobs that
+ * are blocked on I/O are kept apart until their I/O burst completes.
+ * Processes are pulled from the source only once simulated time reaches their
+ * arrival, and jobs are reported and dropped as soon as they finish, so the
+ * engine never holds more than the jobs that are live at the same time.
+ *
+ * Engines may publish their progress while they run. Counts are gathered
+ * locally and only added to the shared progress every so many events, or
+ * every so many ticks for simulations whose events are far apart, so that
+ * engines simulating groups side by side rarely contend for it.
+ *
+ * A simulation may be split into groups of processes that never interact, in
+ * which case each group is simulated by an engine of its own. Such engines
+ * record their results in a shared report and only output their events,
+ * leaving the header, footer and report to the caller.
+ *
+ * Every time the CPU switches to a different job than the one it just ran,
+ * the job only starts running once the switch cost has elapsed. Ticks that
+ * are neither idle nor spent running jobs are overhead.
+ *
+ * Rather than stepping through every tick, simulations jump from one event to
+ * the next. Pending events live on a timing wheel: the arrival of the next
+ * process from the source, the completion or expiry of the running job's
+ * slice, and the completion of each blocked job's I/O burst.
+ */
+typedef struct Engine
+{
+    // Settings
+    Output *out;
+    Source *source;
+    uint runfor;
+    uint quantum;
+    bool quantised; // the scheduler is configured with a quantum
+    uint seed;
+    uint switchcost;
+    uint aging;
+    bool trace;
+    Report *shared; // report of the whole simulation, if simulating one group
+    uint group;
+    Timeline *timeline; // index of the intervals jobs ran for, if any
+    Track *track;       // track of the timeline the engine's CPU records to
+    Progress *progress; // progress shared with other processes, if any
+
+    // State
+    Report *report;
+    Wheel *wheel;
+    Timer arrival;
+    Job *head;
+    Job *tail;
+    Job *running;
+    uint tick;       // current time
+    Job *blocked;
+    size_t nblocked;
+    Job **woken;     // blocked jobs whose I/O burst completes now
+    size_t nwoken;
+    size_t capacity;
+    bool sorted;     // woken jobs are sorted by latest arrival first
+    void *policy;
+
+    // Accounting
+    size_t switches; // context switches
+    ulong busy;      // ticks spent running jobs
+    ulong idle;      // ticks without any ready job
+    ulong io;        // ticks with at least one job blocked on I/O
+    ulong overlap;   // ticks spent running a job while another was blocked
+
+    // Progress not yet published
+    uint published;  // tick progress was last published at
+    uint events;
+    size_t arrived;
+    size_t finished;
+} Engine;
+
+/**
+ * The number of events between each time an engine publishes its progress.
+ */
+#define ENGINE_PUBLISH_EVENTS 1024
+
+/**
+ * The number of ticks after which an engine publishes its progress, however
+ * few events took place, including while it prints a long run of IDLE lines.
+ */
+#define ENGINE_PUBLISH_TICKS (1U << 16)
+
+typedef struct Policy Policy;
+
+/**
+ * The hooks through which a policy drives the engine. Only pick_next is
+ * required; the engine falls back to sensible defaults for the rest.
+ */
+struct Policy
+{
+    // The name printed in the simulation header
+    const char *title;
+
+    // True if the policy reports how jobs fared against their deadlines
+    bool deadlines;
+
+    // True if the policy ages jobs waiting to run
+    bool aging;
+
+    // Sets up and tears down the policy's own state (engine->policy)
+    void (*init)(Engine *engine);
+    void (*destroy)(Engine *engine);
+
+    // A job has become ready to run, having either arrived or completed an
+    // I/O burst
+    void (*on_arrival)(Engine *engine, Job *job);
+
+    // Every event due at the current tick has been handled and at least one
+    // job has become ready. Returns true if the running job, whose remaining
+    // burst is up to date, should be preempted. Never preempts by default.
+    bool (*on_event)(Engine *engine, Job *running);
+
+    // The running job is about to stop running without having finished,
+    // either because its slice expired or because on_event preempted it
+    void (*on_preempt)(Engine *engine, Job *job);
+
+    // Chooses the next job to run among the ready jobs. The previous job is
+    // the one that just stopped running without finishing, if any.
+    Job *(*pick_next)(Engine *engine, Job *previous);
+
+    // The amount of time a job may run before being preempted. Jobs run
+    // until they finish by default.
+    uint (*slice)(Engine *engine, Job *job);
+
+    // The engine specialised for this policy (see ENGINE_SPECIALISE), or NULL
+    // to run the policy through the generic engine
+    void (*run)(Engine *engine);
+};
+
+/**
+ * Prints the simulation header.
+ *
+ * @param engine A pointer to an engine whose settings have been filled in
+ * @param policy A pointer to the policy being simulated
+ */
+void engine_header(Engine *engine, const Policy *policy);
+
+/**
+ * Prints the simulation header unless simulating a group, sets up the engine
+ * state, and initializes the policy.
+ *
+ * @param engine A pointer to an engine whose settings have been filled in
+ * @param policy A pointer to the policy being simulated
+ */
+void engine_start(Engine *engine, const Policy *policy);
+
+/**
+ * Prints the final report unless simulating a group, and tears down the
+ * engine state and the policy. Jobs that are still live and processes that
+ * never arrived are reported as unfinished.
+ *
+ * @param engine A pointer to an engine
+ * @param policy A pointer to the policy being simulated
+ */
+void engine_stop(Engine *engine, const Policy *policy);
+
+/**
+ * Finds the tick of the next pending event, provided it happens within the
+ * simulation.
+ *
+ * @param  engine A pointer to an engine
+ * @param  tick   A pointer to where the tick will be stored
+ * @return        False if the simulation is over
+ */
+bool engine_next(Engine *engine, uint *tick);
+
+/**
+ * Pulls the next process arriving at the given tick from the source and
+ * makes it a live job. Processes without a burst never become live and are
+ * reported straight away. Once no more processes arrive at the tick, the
+ * arrival of the next one is scheduled.
+ *
+ * @param  engine A pointer to an engine
+ * @param  tick   The current time
+ * @return        The new job, or NULL if no more processes arrive now
+ */
+Job *engine_arrive(Engine *engine, uint tick);
+
+/**
+ * Starts running a job, arming its timer to go off once the given slice of
+ * time has elapsed. Switching to a job other than the one that just ran
+ * first costs the switch cost.
+ *
+ * @param engine   A pointer to an engine
+ * @param job      A pointer to the job to run
+ * @param previous A pointer to the job that just stopped running without
+ *                 finishing, if any
+ * @param tick     The current time
+ * @param slice    The amount of time the job may run for
+ */
+void engine_dispatch(Engine *engine, Job *job, Job *previous, uint tick,
+    uint slice);
+
+/**
+ * Stops running a job that hasn't completed its CPU burst, disarming its
+ * timer unless it has just gone off.
+ *
+ * @param engine  A pointer to an engine
+ * @param job     A pointer to the running job
+ * @param tick    The current time
+ * @param expired True if the job's slice has just expired
+ */
+void engine_preempt(Engine *engine, Job *job, uint tick, bool expired);
+
+/**
+ * Blocks a job whose CPU burst has completed on its next I/O burst, arming
+ * its timer to go off once the I/O burst completes.
+ *
+ * @param  engine A pointer to an engine
+ * @param  job    A pointer to the job, which must have cycles left
+ * @param  tick   The current time
+ * @return        The length of the I/O burst
+ */
+uint engine_block(Engine *engine, Job *job, uint tick);
+
+/**
+ * Notes that the I/O burst of a blocked job has completed. The job is made
+ * ready by engine_unblock() once every event due at the current tick has
+ * been handled.
+ *
+ * @param engine A pointer to an engine
+ * @param job    A pointer to the blocked job
+ */
+void engine_wake(Engine *engine, Job *job);
+
+/**
+ * Makes the next job whose I/O burst has completed ready to run its next CPU
+ * burst. Jobs completing I/O at the same time become ready in order of
+ * arrival, after any job arriving at that time.
+ *
+ * @param  engine A pointer to an engine
+ * @return        The job made ready, or NULL if no more jobs woke
+ */
+Job *engine_unblock(Engine *engine);
+
+/**
+ * Reports a job that has finished, then drops it.
+ *
+ * @param engine A pointer to an engine
+ * @param job    A pointer to the finished job
+ * @param tick   The current time
+ */
+void engine_finish(Engine *engine, Job *job, uint tick);
+
+/**
+ * Prints an IDLE line for every tick within a range. When simulating a group,
+ * the lines name the group. Progress is published along the way, as a range
+ * may span most of a simulation.
+ *
+ * @param engine A pointer to an engine
+ * @param from   The first idle tick
+ * @param to     The tick following the last idle tick
+ */
+void engine_idle(Engine *engine, uint from, uint to);
+
+/**
+ * Adds the progress made since it was last published to the shared progress.
+ *
+ * @param engine A pointer to an engine publishing its progress
+ * @param tick   The current time
+ */
+void engine_publish(Engine *engine, uint tick);
+
+/**
+ * Runs a policy through the engine specialised for it, or through the generic
+ * engine, which calls each hook indirectly, if it has none.
+ *
+ * @param engine A pointer to an engine whose settings have been filled in
+ * @param policy A pointer to the policy to simulate
+ */
+void engine_run(Engine *engine, const Policy *policy);
+
+/**
+ * Accounts for the ticks between two events, throughout which no job changes
+ * state.
+ *
+ * @param engine A pointer to an engine
+ * @param from   The tick of the earlier event
+ * @param to     The tick of the later event
+ * @param trace  False if no events should be output
+ */
+engine_inline void engine_elapse(Engine *engine, uint from, uint to,
+    const bool trace)
+{
+    if (!engine->head) {
+        engine->idle += to - from;
+        if (trace) {
+            engine_idle(engine, from, to);
+        }
+    }
+    if (engine->nblocked) {
+        engine->io += to - from;
+        uint dispatched = engine->running ? engine->running->dispatched : to;
+        if (dispatched < to) {
+            engine->overlap += to - (dispatched > from ? dispatched : from);
+        }
+    }
+}
+
+/**
+ * A slice for policies configured with a quantum: a job runs until its
+ * quantum expires or its burst completes, whichever comes first. Without a
+ * quantum, jobs run until their burst completes.
+ *
+ * @param  engine A pointer to an engine
+ * @param  job    A pointer to the job about to run
+ * @return        The amount of time the job may run for
+ */
+static inline uint engine_quantum_slice(Engine *engine, Job *job)
+{
+    uint quantum = engine->quantum;
+    return quantum && quantum < job->burst ? quantum : job->burst;
+}
+
+/**
+ * The simulation loop. Whenever the policy and trace flag are constants, the
+ * loop is specialised for them.
+ *
+ * @param engine A pointer to an engine whose settings have been filled in
+ * @param policy A pointer to the policy to simulate
+ * @param trace  False if no events should be output
+ */
+engine_inline void engine_simulate(Engine *engine, const Policy *policy,
+    const bool trace)
+{
+    Output *out = engine->out;
+    uint tick = 0, next;
+
+    engine_start(engine, policy);
+
+    while (engine_next(engine, &next)) {
+        Job *running = engine->running;
+        Job *previous = NULL;
+        bool expired = false, arrived = false;
+        Timer *timer;
+
+        engine_elapse(engine, tick, next, trace);
+        tick = next;
+        engine->tick = tick;
+        if (engine->progress && (++engine->events == ENGINE_PUBLISH_EVENTS
+            || tick - engine->published >= ENGINE_PUBLISH_TICKS)) {
+            engine_publish(engine, tick);
+        }
+
+        while ((timer = wheel_expire(engine->wheel, tick))) {
+            Job *job;
+            if (running && timer == &running->timer) {
+                expired = true;
+                continue;
+            }
+            if (timer != &engine->arrival) {
+                engine_wake(engine, timer_entry(timer, Job, timer));
+                continue;
+            }
+            while ((job = engine_arrive(engine, tick))) {
+                if (trace) {
+                    output_printf(out, "Time %u: %s arrived\n", tick,
+                        job->name);
+                }
+                if (policy->on_arrival) {
+                    policy->on_arrival(engine, job);
+                }
+                arrived = true;
+            }
+        }
+        while (engine->nwoken) {
+            Job *job = engine_unblock(engine);
+            if (trace) {
+                output_printf(out, "Time %u: %s unblocked\n", tick,
+                    job->name);
+            }
+            if (policy->on_arrival) {
+                policy->on_arrival(engine, job);
+            }
+            arrived = true;
+        }
+
+        if (running) {
+            job_sync(running, tick);
+            if (running->burst == 0
+                && running->cycle < process_cycles(running->process)) {
+                uint io = engine_block(engine, running, tick);
+                if (trace) {
+                    output_printf(out, "Time %u: %s blocked (io %u)\n", tick,
+                        running->name, io);
+                }
+                running = NULL;
+            }
+            else if (running->burst == 0) {
+                if (trace) {
+                    output_printf(out, "Time %u: %s finished\n", tick,
+                        running->name);
+                }
+                engine_finish(engine, running, tick);
+                running = NULL;
+            }
+            else if (expired || (arrived && policy->on_event
+                && policy->on_event(engine, running))) {
+                engine_preempt(engine, running, tick, expired);
+                if (policy->on_preempt) {
+                    policy->on_preempt(engine, running);
+                }
+                previous = running;
+                running = NULL;
+            }
+        }
+
+        if (!running && engine->head) {
+            running = policy->pick_next(engine, previous);
+            if (trace) {
+                output_printf(out, "Time %u: %s selected (burst %u)\n", tick,
+                    running->name, running->burst);
+            }
+            engine_dispatch(engine, running, previous, tick, policy->slice
+                ? policy->slice(engine, running) : running->burst);
+        }
+        engine->running = running;
+    }
+    engine_elapse(engine, tick, engine->runfor, trace);
+
+    engine_stop(engine, policy);
+}
+
+/**
+ * Defines a function running the engine specialised for a policy, with one
+ * copy of the simulation loop for tracing and one for metrics only.
+ *
+ * @param run    The name of the function to define
+ * @param policy The policy, which must be a constant defined beforehand
+ */
+#define ENGINE_SPECIALISE(run, policy)               \
+    static void run(Engine *engine)                  \
+    {                                                \
+        if (engine->trace) {                         \
+            engine_simulate(engine, &policy, true);  \
+        }                                            \
+        else {                                       \
+            engine_simulate(engine, &policy, false); \
+        }                                            \
+    }
+
+// #endregion ------------------------------------------------------------------
+
+// #region Policies ------------------------------------------------------------
+
+extern const Policy policy_fcfs;
+extern const Policy policy_sjf;
+extern const Policy policy_rr;
+extern const Policy policy_edf;
+extern const Policy policy_stride;
+extern const Policy policy_lottery;
+extern const Policy policy_priority;
+
+// #endregion ------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef FENWICK_H
+#define FENWICK_H
+
+#include <stdlib.h>
+#include <types.h>
+
+typedef struct Fenwick Fenwick;
+
+/**
+ * Creates a Fenwick (binary indexed) tree over an array of weights, all of
+ * which start out as zero. Updating a weight, summing a prefix of weights and
+ * finding the index a running total falls on are all O(log n).
+ *
+ * @param  size The number of weights
+ * @return      A pointer to a new tree
+ */
+Fenwick *fenwick_new(size_t size);
+
+/**
+ * Frees all memory associated with a tree object.
+ *
+ * @param tree A pointer to the tree object to FELL
+ */
+void fenwick_destroy(Fenwick *tree);
+
+/**
+ * @param  tree A pointer to a tree object
+ * @return      The number of weights
+ */
+size_t fenwick_size(Fenwick *tree);
+
+/**
+ * Grows the array of weights, keeping existing weights and setting new ones
+ * to zero. Takes O(n) time.
+ *
+ * @param tree A pointer to a tree object
+ * @param size The new number of weights, no less than the current one
+ */
+void fenwick_grow(Fenwick *tree, size_t size);
+
+/**
+ * @param tree   A pointer to a tree object
+ * @param index  The index of the weight to set
+ * @param weight The new weight
+ */
+void fenwick_set(Fenwick *tree, size_t index, ulong weight);
+
+/**
+ * @param  tree A pointer to a tree object
+ * @return      The sum of all weights
+ */
+ulong fenwick_total(Fenwick *tree);
+
+/**
+ * Finds the index a running total falls on, being the least index for which
+ * the sum of the weights up to and including it exceeds the total.
+ *
+ * @param  tree  A pointer to a tree object
+ * @param  total A running total less than the sum of all weights
+ * @return       The index the running total falls on
+ */
+size_t fenwick_find(Fenwick *tree, ulong total);
+
+#endif
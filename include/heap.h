@@ -0,0 +1,60 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <types.h>
+
+typedef struct Heap Heap;
+
+/**
+ * Creates a binary min-heap. Items are ordered by key, then by sequence
+ * number, so that items sharing a key come out in the order given by their
+ * sequence numbers. Pushing and popping are O(log n).
+ *
+ * @return A pointer to a new heap
+ */
+Heap *heap_new();
+
+/**
+ * Frees all memory associated with a heap object. Items still held are not
+ * freed.
+ *
+ * @param heap A pointer to the heap object to FLATTEN
+ */
+void heap_destroy(Heap *heap);
+
+/**
+ * @param  heap A pointer to a heap object
+ * @return      The number of items held by the heap
+ */
+size_t heap_size(Heap *heap);
+
+/**
+ * @param heap A pointer to a heap object
+ * @param key  The key to order the item by
+ * @param seq  The sequence number to break ties between keys with
+ * @param item The item to push
+ */
+void heap_push(Heap *heap, ulong key, size_t seq, void *item);
+
+/**
+ * Looks at the least item without removing it.
+ *
+ * @param  heap A pointer to a heap object
+ * @param  key  A pointer to where the item's key will be stored (may be NULL)
+ * @param  seq  A pointer to where the item's sequence number will be stored
+ *              (may be NULL)
+ * @return      The least item, or NULL if the heap is empty
+ */
+void *heap_peek(Heap *heap, ulong *key, size_t *seq);
+
+/**
+ * Removes the least item.
+ *
+ * @param  heap A pointer to a heap object
+ * @return      The least item, or NULL if the heap is empty
+ */
+void *heap_pop(Heap *heap);
+
+#endif
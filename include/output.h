@@ -0,0 +1,113 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <progress.h>
+#include <types.h>
+
+/**
+ * The size of each output buffer unless specified otherwise.
+ */
+#define OUTPUT_BUFFER_DEFAULT (1 << 20)
+
+typedef enum OutputFlags {
+    OUTPUT_ASYNC = 1 << 0, // drain buffers on a dedicated writer thread
+    OUTPUT_DIRECT = 1 << 1 // bypass the page cache using O_DIRECT
+} OutputFlags;
+
+typedef struct Output Output;
+
+/**
+ * Creates (or truncates) an output file. Text is gathered into large buffers
+ * that are written out with a single write() each.
+ *
+ * When writing asynchronously, two buffers are used: the caller fills one
+ * while a writer thread drains the other. Should the caller get a whole
+ * buffer ahead of the writer, it blocks until the writer catches up, so no
+ * more than two buffers' worth of text is ever held in memory.
+ *
+ * Writing directly bypasses the page cache. Should the file system not
+ * support it, the file is written normally instead.
+ *
+ * @param  filepath    The path of the file to create
+ * @param  flags       A combination of OutputFlags
+ * @param  buffer      The size of each buffer, rounded up to the block size
+ * @param  preallocate The number of bytes to reserve on disk up front
+ * @return             A pointer to a new output, or NULL if opening failed
+ */
+Output *output_open(const char *filepath, int flags, size_t buffer,
+    off_t preallocate);
+
+/**
+ * Creates an output backed by an anonymous temporary file, from which the
+ * text can be read back through output_map().
+ *
+ * @param  buffer The size of the buffer, rounded up to the block size
+ * @return        A pointer to a new output
+ */
+Output *output_spool(size_t buffer);
+
+/**
+ * Counts every byte an output writes to its file towards published progress.
+ *
+ * @param out      A pointer to an output object
+ * @param progress A pointer to the progress to count bytes towards
+ */
+void output_progress(Output *out, Progress *progress);
+
+/**
+ * Writes out any buffered text, then maps all of the text appended so far
+ * into memory. The mapping remains valid until the output is closed, and
+ * only one mapping may be made per output.
+ *
+ * @param  out    A pointer to an output object created by output_spool()
+ * @param  length A pointer to where the length of the text will be stored
+ * @return        A pointer to the text, or NULL if there is none
+ */
+const char *output_map(Output *out, size_t *length);
+
+/**
+ * @param  out A pointer to an output object
+ * @return     The number of bytes appended so far
+ */
+size_t output_tell(Output *out);
+
+/**
+ * Writes out any buffered text, waits for the writer thread to finish, then
+ * closes the file and frees all memory associated with the output object.
+ * Preallocated space beyond the end of the text is released.
+ *
+ * @param out A pointer to the output object to SEAL
+ */
+void output_close(Output *out);
+
+/**
+ * Appends formatted text to an output.
+ *
+ * @param out     A pointer to an output object
+ * @param format  The format of the text
+ * @param VARARGS Arguments to inline in the formatted text
+ */
+void output_printf(Output *out, const char *format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * Appends raw bytes to an output.
+ *
+ * @param out  A pointer to an output object
+ * @param data The bytes to append
+ * @param size The number of bytes to append
+ */
+void output_write(Output *out, const char *data, size_t size);
+
+/**
+ * Appends a string to an output.
+ *
+ * @param out A pointer to an output object
+ * @param str The string to append
+ */
+void output_puts(Output *out, const char *str);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <stdbool.h>
+#include <engine.h>
+
+/**
+ * Simulates each group of processes on a partition of its own. Groups never
+ * interact, so every partition is simulated by an engine of its own, spread
+ * across one worker thread per online CPU. Each worker spools the events of
+ * the partitions it simulates, and once every partition has been simulated
+ * the spools are merged by time into the output, events at the same time
+ * being ordered by group. Results are reported in order of arrival among
+ * every process, exactly as though the groups had been simulated together.
+ *
+ * @param  engine A pointer to an engine whose settings have been filled in,
+ *                used as a template for the engine of each partition
+ * @param  policy A pointer to the policy to simulate
+ * @return        False if the processes all belong to one group, in which
+ *                case nothing is simulated
+ */
+bool partition_run(Engine *engine, const Policy *policy);
+
+#endif
@@ -1,12 +1,34 @@
 #ifndef PROCESS_H
 #define PROCESS_H
 
+#include <limits.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <types.h>
 
 // #region Process -------------------------------------------------------------
 
+/**
+ * The maximum length of a process name that can be read from a configuration.
+ */
+#define PROCESS_NAME_MAX 20
+
+/**
+ * The deadline of a process that doesn't have one.
+ */
+#define PROCESS_NO_DEADLINE UINT_MAX
+
+/**
+ * The number of tickets held by a process unless specified otherwise.
+ */
+#define PROCESS_TICKETS_DEFAULT 100
+
+/**
+ * The number of priority levels. Priority 0 is the highest, and is held by
+ * processes unless specified otherwise.
+ */
+#define PROCESS_PRIORITY_LEVELS 64
+
 typedef struct Process Process;
 
 /**
@@ -42,6 +64,89 @@ uint process_burst(Process *process);
  */
 uint process_arrival(Process *process);
 
+/**
+ * @param  process A pointer to a process object
+ * @return         The deadline of the process relative to its arrival, or
+ *                 PROCESS_NO_DEADLINE
+ */
+uint process_deadline(Process *process);
+
+/**
+ * @param process  A pointer to a process object
+ * @param deadline The deadline of the process relative to its arrival
+ */
+void process_set_deadline(Process *process, uint deadline);
+
+/**
+ * @param  process A pointer to a process object
+ * @return         The number of tickets held by the process
+ */
+uint process_tickets(Process *process);
+
+/**
+ * @param process A pointer to a process object
+ * @param tickets The number of tickets held by the process
+ */
+void process_set_tickets(Process *process, uint tickets);
+
+/**
+ * @param  process A pointer to a process object
+ * @return         The priority of the process, 0 being the highest
+ */
+uint process_priority(Process *process);
+
+/**
+ * @param process  A pointer to a process object
+ * @param priority The priority of the process, below PROCESS_PRIORITY_LEVELS
+ */
+void process_set_priority(Process *process, uint priority);
+
+/**
+ * @param  process A pointer to a process object
+ * @return         The group of processes sharing a partition of the CPUs
+ */
+uint process_group(Process *process);
+
+/**
+ * @param process A pointer to a process object
+ * @param group   The group of processes sharing a partition of the CPUs
+ */
+void process_set_group(Process *process, uint group);
+
+/**
+ * A process alternates between CPU and I/O bursts, starting and ending with a
+ * CPU burst. The first CPU burst is the burst of the process; each cycle that
+ * follows is an I/O burst, during which the process is blocked, followed by
+ * another CPU burst.
+ *
+ * @param  process A pointer to a process object
+ * @return         The number of cycles following the first CPU burst
+ */
+size_t process_cycles(Process *process);
+
+/**
+ * @param  process A pointer to a process object
+ * @param  cycle   The index of a cycle
+ * @return         The length of the I/O burst of the cycle
+ */
+uint process_io(Process *process, size_t cycle);
+
+/**
+ * @param  process A pointer to a process object
+ * @param  cycle   The index of a cycle
+ * @return         The length of the CPU burst of the cycle
+ */
+uint process_cycle_burst(Process *process, size_t cycle);
+
+/**
+ * Appends a cycle to a process.
+ *
+ * @param process A pointer to a process object
+ * @param io      The length of the I/O burst
+ * @param burst   The length of the CPU burst following it
+ */
+void process_add_cycle(Process *process, uint io, uint burst);
+
 // #endregion ------------------------------------------------------------------
 
 // #region ProcessList ---------------------------------------------------------
@@ -0,0 +1,111 @@
+#ifndef PROGRESS_H
+#define PROGRESS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <types.h>
+
+/**
+ * The progress of a running simulation, published in shared memory so that
+ * it can be watched from other processes. Counters are only ever updated
+ * with relaxed atomics: readers may see them slightly out of step with one
+ * another, but never torn.
+ *
+ * Every simulation publishes its progress under PROGRESS_PREFIX followed by
+ * its process ID, and withdraws it when it exits.
+ */
+#define PROGRESS_MAGIC ("SCHEDPR1")
+#define PROGRESS_PREFIX ("process-scheduler.")
+
+typedef struct
+{
+    char magic[8];
+    uint64_t pid;
+    uint64_t runfor;    // ticks to simulate on each CPU
+    uint64_t cpus;      // CPUs simulated, being one per group of processes
+    uint64_t processes; // processes to simulate
+    uint64_t ticks;     // ticks simulated, summed over every CPU
+    uint64_t events;    // events processed
+    uint64_t arrived;   // jobs arrived
+    uint64_t finished;  // jobs finished
+    uint64_t written;   // bytes of output written
+    uint64_t done;      // nonzero once every CPU has been simulated
+} Progress;
+
+/**
+ * Publishes the progress of the calling process.
+ *
+ * @param  runfor    The length of the simulation
+ * @param  processes The number of processes to simulate
+ * @return           A pointer to the shared progress, or NULL if shared memory
+ *                   isn't available
+ */
+Progress *progress_publish(uint runfor, size_t processes);
+
+/**
+ * Withdraws progress published by the calling process.
+ *
+ * @param progress A pointer to the progress to REDACT, or NULL
+ */
+void progress_withdraw(Progress *progress);
+
+/**
+ * Removes the name of the progress published by the calling process, leaving
+ * it mapped. Only async-signal-safe calls are made, so that progress doesn't
+ * outlive a process killed by a signal.
+ */
+void progress_unlink(void);
+
+/**
+ * Removes the progress left behind by a process that exited without
+ * withdrawing it.
+ *
+ * @param  pid The ID of the process
+ * @return     False if the progress couldn't be removed
+ */
+bool progress_remove(pid_t pid);
+
+/**
+ * Maps the progress published by another process, read-only.
+ *
+ * @param  pid The ID of the process
+ * @return     A pointer to its progress, or NULL if it hasn't published any
+ */
+const Progress *progress_attach(pid_t pid);
+
+/**
+ * Unmaps progress mapped by progress_attach().
+ *
+ * @param progress A pointer to the progress
+ */
+void progress_detach(const Progress *progress);
+
+/**
+ * @param counter A pointer to a counter of shared progress
+ * @param n       The amount to add
+ */
+static inline void progress_add(uint64_t *counter, uint64_t n)
+{
+    __atomic_fetch_add(counter, n, __ATOMIC_RELAXED);
+}
+
+/**
+ * @param counter A pointer to a counter of shared progress
+ * @param value   The value to store
+ */
+static inline void progress_store(uint64_t *counter, uint64_t value)
+{
+    __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+}
+
+/**
+ * @param  counter A pointer to a counter of shared progress
+ * @return         The value of the counter
+ */
+static inline uint64_t progress_load(const uint64_t *counter)
+{
+    return __atomic_load_n(counter, __ATOMIC_RELAXED);
+}
+
+#endif
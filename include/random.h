@@ -0,0 +1,34 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <types.h>
+
+/**
+ * A small, fast pseudo-random number generator (xoshiro256**). Sequences only
+ * depend on the seed, so simulations can be reproduced on any platform.
+ */
+typedef struct Random
+{
+    unsigned long long state[4];
+} Random;
+
+/**
+ * @param random A pointer to the generator to seed
+ * @param seed   The seed to start the sequence from
+ */
+void random_seed(Random *random, ulong seed);
+
+/**
+ * @param  random A pointer to a generator
+ * @return        The next 64 random bits of the sequence
+ */
+unsigned long long random_next(Random *random);
+
+/**
+ * @param  random A pointer to a generator
+ * @param  bound  The upper bound, which must be positive
+ * @return        A uniformly distributed integer within [0, bound)
+ */
+ulong random_below(Random *random, ulong bound);
+
+#endif
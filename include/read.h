@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <process.h>
 #include <scheduler.h>
 #include <types.h>
 
@@ -21,6 +22,30 @@ extern ulong lineno;
  */
 bool read_use(SchedulerType *result, FILE *stream);
 
+/**
+ * Reads a line and parses a process from it. The name, arrival and burst of
+ * the process may be followed by any of these optional attributes:
+ *
+ *   deadline <n>  The time within which the process should finish, relative
+ *                 to its arrival
+ *   tickets <n>   The share of the processor the process is entitled to,
+ *                 which must be positive
+ *   priority <n>  The priority of the process, from 0, the highest, up to
+ *                 PROCESS_PRIORITY_LEVELS - 1
+ *   group <n>     The group of processes sharing a partition of the CPUs,
+ *                 which never interact with other groups
+ *   io <n> burst <m>
+ *                 An I/O burst of n ticks, followed by another CPU burst of
+ *                 m ticks, both of which must be positive. Any number of
+ *                 these may follow one another, provided the first burst of
+ *                 the process is positive.
+ *
+ * @param  result A pointer to where the new process will be stored
+ * @param  stream The stream to read from
+ * @return        True if successful
+ */
+bool read_process(Process **result, FILE *stream);
+
 /**
  * Reads a specified number of lines, and parses a process from each of them.
  *
@@ -49,6 +74,17 @@ bool read_runfor(uint *result, FILE *stream);
  */
 bool read_processcount(size_t *result, FILE *stream);
 
+/**
+ * Reads a line and parses out an optional setting, being a name followed by a
+ * value. Should the line hold anything else, it is left to be read again.
+ *
+ * @param  name   The name of the setting
+ * @param  result A pointer to where the value of the setting will be stored
+ * @param  stream The stream to read from
+ * @return        True if the setting was read
+ */
+bool read_setting(const char *name, uint *result, FILE *stream);
+
 /**
  * Reads a line and parses out the quantum.
  *
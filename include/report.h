@@ -0,0 +1,91 @@
+#ifndef REPORT_H
+#define REPORT_H
+
+#include <stdbool.h>
+#include <output.h>
+#include <types.h>
+
+typedef struct Report Report;
+
+/**
+ * Creates a report holding the wait and turnaround times of a fixed number of
+ * jobs. Results are keyed by the order in which jobs arrived, so they can be
+ * recorded in any order and still be printed in order of arrival. A spooled
+ * report keeps its results in a memory mapped temporary file rather than on
+ * the heap, which keeps memory usage independent of the number of jobs.
+ *
+ * A report on deadlines additionally prints the lateness of each job and
+ * whether it missed its deadline, followed by the ratio of missed deadlines.
+ *
+ * @param  count     The number of jobs the report holds
+ * @param  spool     True if results should be kept on disk
+ * @param  deadlines True if the report is on deadlines
+ * @return           A pointer to a new report
+ */
+Report *report_new(size_t count, bool spool, bool deadlines);
+
+/**
+ * Frees all memory associated with a report object.
+ *
+ * @param report A pointer to the report object to CRUMPLE
+ */
+void report_destroy(Report *report);
+
+/**
+ * Records the results of a job. Names longer than PROCESS_NAME_MAX are
+ * truncated.
+ *
+ * @param report     A pointer to a report object
+ * @param seq        The position of the job in order of arrival
+ * @param name       The name of the job
+ * @param wait       The amount of time the job spent waiting
+ * @param turnaround The amount of time between arrival and completion
+ */
+void report_set(Report *report, size_t seq, const char *name, uint wait,
+    uint turnaround);
+
+/**
+ * Records how a job fared against its deadline. Must follow report_set().
+ * Jobs for which this is never called are reported as having no deadline.
+ *
+ * @param report   A pointer to a report object
+ * @param seq      The position of the job in order of arrival
+ * @param finished True if the job finished, in which case its lateness is
+ *                 known
+ * @param lateness The amount of time between the deadline and completion
+ * @param missed   True if the job missed its deadline
+ */
+void report_set_deadline(Report *report, size_t seq, bool finished,
+    long lateness, bool missed);
+
+/**
+ * How the CPUs were used over the course of a simulation.
+ */
+typedef struct Usage
+{
+    size_t switches; // context switches
+    ulong overhead;  // ticks spent switching contexts
+    ulong busy;      // ticks spent running jobs
+    ulong io;        // ticks with at least one job blocked on I/O
+    ulong overlap;   // ticks spent running a job while another was blocked
+    ulong capacity;  // ticks the CPUs were available for
+} Usage;
+
+/**
+ * Records how the CPUs were used, to be printed after the results of every
+ * job. I/O is only reported if jobs were ever blocked on it.
+ *
+ * @param report A pointer to a report object
+ * @param usage  A pointer to the usage to record
+ */
+void report_set_usage(Report *report, const Usage *usage);
+
+/**
+ * Prints the results of every job in order of arrival.
+ *
+ * @param report A pointer to a report object
+ * @param out    The output to print results to
+ */
+void report_print(Report *report, Output *out);
+
+#endif
@@ -1,41 +1,37 @@
 #ifndef SCHEDULER_H
 #define SCHEDULER_H
 
-#include <stdio.h>
-#include <process.h>
-
-typedef enum SchedulerType {
-    SCHEDULER_FCFS, // first in first out
-    SCHEDULER_SJF,  // shortest job first
-    SCHEDULER_RR,   // round robin
-    SCHEDULER_UNDEF // undefined
-} SchedulerType;
-
-/**
- * Runs a "first come, first served" scheduler simulation.
- *
- * @param out       The file to output simulation results to
- * @param runfor    The amount of time to run the simulation for
- * @param processes The processes to run the simulation with
- */
-void run_fcfs(FILE *out, uint runfor, ProcessList *processes);
+#include <stdbool.h>
+#include <output.h>
+#include <progress.h>
+#include <schedulertype.h>
+#include <source.h>
+#include <timeline.h>
 
 /**
- * Runs a "shortest job first" scheduler simulation.
- *
- * @param out       The file to output simulation results to
- * @param runfor    The amount of time to run the simulation for
- * @param processes The processes to run the simulation with
+ * The parameters of a scheduler simulation.
  */
-void run_sjf(FILE *out, uint runfor, ProcessList *processes);
+typedef struct Settings
+{
+    uint runfor;  // The amount of time to run the simulation for
+    uint quantum; // The maximum amount of time alloted to each running process
+    uint seed;    // The seed of randomized schedulers
+    uint switchcost; // The overhead of every context switch
+    uint aging;   // The time a process waits for its priority to rise a level
+    bool trace;   // False if only wait and turnaround times should be output
+    Timeline *timeline; // The index to record the intervals jobs ran for to
+    Progress *progress; // The progress to publish while simulating
+} Settings;
 
 /**
- * Runs a "round-robin" scheduler simulation.
+ * Runs a scheduler simulation.
  *
- * @param out       The file to output simulation results to
- * @param runfor    The amount of time to run the simulation for
- * @param processes The processes to run the simulation with
+ * @param type     The scheduler to simulate, other than SCHEDULER_UNDEF
+ * @param out      The output to write simulation results to
+ * @param source   The processes to run the simulation with
+ * @param settings The parameters of the simulation
  */
-void run_rr(FILE *out, uint runfor, uint quantum, ProcessList *processes);
+void scheduler_run(SchedulerType type, Output *out, Source *source,
+    const Settings *settings);
 
 #endif
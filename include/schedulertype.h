@@ -0,0 +1,35 @@
+#ifndef SCHEDULERTYPE_H
+#define SCHEDULERTYPE_H
+
+#include <stdbool.h>
+
+typedef enum SchedulerType {
+    SCHEDULER_FCFS,     // first in first out
+    SCHEDULER_SJF,      // shortest job first
+    SCHEDULER_RR,       // round robin
+    SCHEDULER_EDF,      // earliest deadline first
+    SCHEDULER_STRIDE,   // stride (deterministic proportional share)
+    SCHEDULER_LOTTERY,  // lottery (randomized proportional share)
+    SCHEDULER_PRIORITY, // static priority with aging
+    SCHEDULER_UNDEF     // undefined
+} SchedulerType;
+
+/**
+ * @param  type A scheduler type other than SCHEDULER_UNDEF
+ * @return      The name used to select the scheduler within a configuration
+ */
+const char *scheduler_name(SchedulerType type);
+
+/**
+ * @param  type A scheduler type other than SCHEDULER_UNDEF
+ * @return      True if the scheduler is configured with a quantum
+ */
+bool scheduler_quantum(SchedulerType type);
+
+/**
+ * @param  name The name used to select a scheduler within a configuration
+ * @return      The scheduler type so named, or SCHEDULER_UNDEF if none is
+ */
+SchedulerType scheduler_type(const char *name);
+
+#endif
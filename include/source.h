@@ -0,0 +1,110 @@
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <process.h>
+#include <types.h>
+
+typedef struct Source Source;
+
+/**
+ * Creates a source that yields the processes of a fully loaded process list
+ * in order of arrival. Processes arriving at the same time are yielded in the
+ * order they appear within the list. The list remains owned by the caller.
+ *
+ * @param  processes The processes to yield (may be NULL)
+ * @return           A pointer to a new source
+ */
+Source *source_list(ProcessList *processes);
+
+/**
+ * Creates a source that lazily reads processes from a stream positioned just
+ * past the configuration header. Processes are only parsed once they are
+ * asked for, so the stream must list them in order of arrival. Once the last
+ * process has been read, the end of the configuration is verified. Malformed
+ * or out of order lines are reported through error_exit().
+ *
+ * @param  stream   The stream to read processes from
+ * @param  count    The number of processes the stream holds
+ * @param  filepath The name of the stream, used when reporting errors
+ * @return          A pointer to a new source
+ */
+Source *source_stream(FILE *stream, size_t count, const char *filepath);
+
+/**
+ * Splits a fully loaded source into one source per group of processes, in
+ * ascending order of group. Each yields the processes of its group in order
+ * of arrival, keeping their position in order of arrival among every process
+ * (see source_seq()). The processes remain owned by the caller of
+ * source_list().
+ *
+ * @param  source A pointer to a source object
+ * @param  count  A pointer to where the number of groups will be stored
+ * @return        An array of new sources, or NULL if the source is lazy or
+ *                every process belongs to the same group
+ */
+Source **source_split(Source *source, size_t *count);
+
+/**
+ * Frees all memory associated with a source object. Processes that were
+ * never yielded are discarded.
+ *
+ * @param source A pointer to the source object to SHRED
+ */
+void source_destroy(Source *source);
+
+/**
+ * @param  source A pointer to a source object
+ * @return        The total number of processes the source yields
+ */
+size_t source_count(Source *source);
+
+/**
+ * @param  source A pointer to a source object split off another
+ * @return        The group of every process the source yields
+ */
+uint source_group(Source *source);
+
+/**
+ * @param  source A pointer to a source object
+ * @return        True if processes are read on demand rather than preloaded
+ */
+bool source_lazy(Source *source);
+
+/**
+ * Peeks at the arrival time of the next process without consuming it.
+ *
+ * @param  source  A pointer to a source object
+ * @param  arrival A pointer to where the arrival time will be stored
+ * @return         False if the source has been exhausted
+ */
+bool source_peek(Source *source, uint *arrival);
+
+/**
+ * @param  source A pointer to a source object
+ * @return        The position of the next process in order of arrival among
+ *                every process, including those of other groups should the
+ *                source have been split off another
+ */
+size_t source_seq(Source *source);
+
+/**
+ * Consumes the next process. The process must be handed back through
+ * source_release() once it is no longer referenced.
+ *
+ * @param  source A pointer to a source object
+ * @return        The next process, or NULL if the source has been exhausted
+ */
+Process *source_next(Source *source);
+
+/**
+ * Hands a consumed process back to its source, which frees it if it was
+ * read on demand.
+ *
+ * @param source  A pointer to a source object
+ * @param process A pointer to a process previously returned by source_next()
+ */
+void source_release(Source *source, Process *process);
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <types.h>
+
+// #region File Format ---------------------------------------------------------
+
+/**
+ * A timeline index records every interval of time a job spent running, so
+ * that the job running at any time, or every interval one job ran, can be
+ * looked up by binary search rather than by scanning the trace.
+ *
+ * The file starts with a header, followed by the tables it points at. Each
+ * CPU, being one group when processes are grouped, has a track of segments
+ * sorted by time. Every segment links to the previous segment of its job, and
+ * every job links to its last segment, so the segments of one job can be
+ * walked backwards without a search. Jobs are listed in order of arrival,
+ * followed by the positions of the jobs sorted by name. Fields are stored in
+ * the byte order of the machine that ran the simulation.
+ */
+#define TIMELINE_MAGIC ("SCHEDTL1")
+
+/**
+ * The index of a segment that doesn't exist.
+ */
+#define TIMELINE_NONE UINT64_MAX
+
+typedef struct
+{
+    char magic[8];
+    uint32_t runfor;
+    uint32_t ntracks;
+    uint64_t nsegments;
+    uint64_t njobs;
+    uint64_t tracks;   // offset of the tracks
+    uint64_t segments; // offset of the segments
+    uint64_t jobs;     // offset of the jobs, in order of arrival
+    uint64_t names;    // offset of the positions of the jobs sorted by name
+} TimelineHeader;
+
+typedef struct
+{
+    uint32_t group;
+    uint32_t reserved;
+    uint64_t first; // index of the first segment of the track
+    uint64_t count;
+} TimelineTrack;
+
+typedef struct
+{
+    uint32_t start;
+    uint32_t end;  // exclusive
+    uint64_t seq;  // position of the job in order of arrival
+    uint64_t prev; // index of the previous segment of the job
+} TimelineSegment;
+
+typedef struct
+{
+    char name[24];
+    uint64_t last;  // index of the last segment of the job
+    uint64_t count; // number of segments of the job
+} TimelineJob;
+
+// #endregion ------------------------------------------------------------------
+
+// #region Timeline ------------------------------------------------------------
+
+typedef struct Timeline Timeline;
+typedef struct Track Track;
+
+/**
+ * Creates a timeline index for a number of jobs. Segments are spooled to
+ * temporary files as they are recorded, so that only the jobs are held in
+ * memory. Jobs beyond that number are made room for as they are named or
+ * recorded, which is only safe while a single track is recorded to.
+ *
+ * @param  count The number of jobs known up front, if any
+ * @return       A pointer to a new timeline
+ */
+Timeline *timeline_new(size_t count);
+
+/**
+ * Frees all memory associated with a timeline object, including its tracks.
+ *
+ * @param timeline A pointer to the timeline object to SHRED
+ */
+void timeline_destroy(Timeline *timeline);
+
+/**
+ * Adds a track for the segments run by one CPU. Tracks must be added in
+ * order of group, before any of them are recorded to. Different tracks may
+ * then be recorded to from different threads, provided each job is only
+ * ever recorded to one track.
+ *
+ * @param  timeline A pointer to a timeline object
+ * @param  group    The group of the jobs the CPU runs
+ * @return          A pointer to the new track
+ */
+Track *timeline_track(Timeline *timeline, uint group);
+
+/**
+ * Names a job. Names longer than PROCESS_NAME_MAX are truncated.
+ *
+ * @param track A pointer to a track of the timeline
+ * @param seq   The position of the job in order of arrival
+ * @param name  The name of the job
+ */
+void track_name(Track *track, size_t seq, const char *name);
+
+/**
+ * Records an interval of time a job spent running. Intervals must be
+ * recorded in order of time. An interval picking up exactly where the same
+ * job left off extends the last segment instead.
+ *
+ * @param track A pointer to a track object
+ * @param seq   The position of the job in order of arrival
+ * @param start The time the job started running
+ * @param end   The time the job stopped running
+ */
+void track_add(Track *track, size_t seq, uint start, uint end);
+
+/**
+ * Writes out the index.
+ *
+ * @param  timeline A pointer to a timeline object
+ * @param  filepath The path of the file to create
+ * @param  runfor   The length of the simulation
+ * @return          False if the file couldn't be written
+ */
+bool timeline_write(Timeline *timeline, const char *filepath, uint runfor);
+
+// #endregion ------------------------------------------------------------------
+
+#endif
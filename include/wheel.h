@@ -0,0 +1,94 @@
+#ifndef WHEEL_H
+#define WHEEL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <types.h>
+
+typedef struct Wheel Wheel;
+
+/**
+ * A timer is embedded within whatever object needs to be woken up, and is
+ * linked into a wheel while pending. Its fields are owned by the wheel.
+ */
+typedef struct Timer
+{
+    struct Timer *prev;
+    struct Timer *next;
+    ulong expiry;
+    unsigned char level;
+    unsigned char slot;
+} Timer;
+
+/**
+ * Recovers a pointer to the object a timer is embedded within.
+ *
+ * @param  timer  A pointer to the timer
+ * @param  type   The type of the enclosing object
+ * @param  member The name of the timer within the enclosing object
+ * @return        A pointer to the enclosing object
+ */
+#define timer_entry(timer, type, member) \
+    ((type *) ((char *) (timer) - offsetof(type, member)))
+
+/**
+ * Creates a hierarchical timing wheel. Each level of the wheel divides time
+ * into 64 slots that are 64 times coarser than those of the level below it.
+ * Timers are filed into the coarsest level whose slot still sets them apart
+ * from the current time, and cascade into finer levels as time catches up
+ * with them. Adding, cancelling and expiring a timer are amortised O(1), and
+ * finding the next due time only ever inspects one occupancy bitmap per level.
+ *
+ * @param  now The time the wheel starts at
+ * @return     A pointer to a new wheel
+ */
+Wheel *wheel_new(ulong now);
+
+/**
+ * Frees all memory associated with a wheel object. Pending timers are simply
+ * forgotten.
+ *
+ * @param wheel A pointer to the wheel object to SPIN OFF
+ */
+void wheel_destroy(Wheel *wheel);
+
+/**
+ * Arms a timer. Timers expiring at the same time expire in the order they
+ * were armed.
+ *
+ * @param wheel  A pointer to a wheel object
+ * @param timer  A pointer to a timer that isn't pending
+ * @param expiry The time the timer expires at, which mustn't lie in the past
+ */
+void wheel_add(Wheel *wheel, Timer *timer, ulong expiry);
+
+/**
+ * Disarms a pending timer.
+ *
+ * @param wheel A pointer to a wheel object
+ * @param timer A pointer to a pending timer
+ */
+void wheel_cancel(Wheel *wheel, Timer *timer);
+
+/**
+ * Finds the time at which the next pending timer expires. The wheel may move
+ * its current time forward while searching, but never past the returned time,
+ * so no timers may be armed before it afterwards.
+ *
+ * @param  wheel A pointer to a wheel object
+ * @param  due   A pointer to where the next expiry time will be stored
+ * @return       False if no timers are pending
+ */
+bool wheel_next(Wheel *wheel, ulong *due);
+
+/**
+ * Moves the current time of the wheel forward and disarms the next timer
+ * expiring at that time. No timer may be pending for an earlier time.
+ *
+ * @param  wheel A pointer to a wheel object
+ * @param  now   The new current time
+ * @return       The expired timer, or NULL if no more timers expire now
+ */
+Timer *wheel_expire(Wheel *wheel, ulong now);
+
+#endif
@@ -6,13 +6,15 @@
 
 #define try(read) if (!read) return false
 
-ulong lineno;
-
 struct Config
 {
     uint runfor;
     uint quantum;
+    uint seed;
+    uint switchcost;
+    uint aging;
     SchedulerType use;
+    size_t processcount;
     ProcessList *processes;
 };
 
@@ -31,27 +33,55 @@ uint config_quantum(Config *config)
     return config->quantum;
 }
 
+uint config_seed(Config *config)
+{
+    return config->seed;
+}
+
+uint config_switchcost(Config *config)
+{
+    return config->switchcost;
+}
+
+uint config_aging(Config *config)
+{
+    return config->aging;
+}
+
+size_t config_processcount(Config *config)
+{
+    return config->processcount;
+}
+
 ProcessList *config_processes(Config *config)
 {
     return config->processes;
 }
 
-bool config_load(Config **dest, FILE *cf)
+bool config_load(Config **dest, FILE *cf, bool stream)
 {
-    Config config = { 0, 0, SCHEDULER_UNDEF, NULL };
-    size_t processcount = 0;
+    Config config = {
+        0, 0, CONFIG_SEED_DEFAULT, 0, 0, SCHEDULER_UNDEF, 0, NULL
+    };
     lineno = 1;
 
-    try(read_processcount(&processcount, cf));
+    try(read_processcount(&config.processcount, cf));
     try(read_runfor(&config.runfor, cf));
     try(read_use(&config.use, cf));
-    if (config.use == SCHEDULER_RR) {
+    if (scheduler_quantum(config.use)) {
         try(read_quantum(&config.quantum, cf));
     }
-    if (processcount > 0) {
-        try(read_processes(&config.processes, processcount, cf));
+    while (read_setting("seed", &config.seed, cf)
+        || read_setting("switchcost", &config.switchcost, cf)
+        || read_setting("aging", &config.aging, cf)) {
+        // Optional settings may come in any order
+    }
+    if (!stream) {
+        if (config.processcount > 0) {
+            try(read_processes(&config.processes, config.processcount, cf));
+        }
+        try(read_end(cf));
     }
-    try(read_end(cf));
 
     *dest = amalloc(sizeof(Config));
     memcpy(*dest, &config, sizeof(Config));
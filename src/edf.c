@@ -0,0 +1,67 @@
+#include <heap.h>
+#include <engine.h>
+
+/**
+ * @return The absolute deadline of a job, which for jobs without a deadline
+ *         lies beyond that of any job with one
+ */
+static ulong deadline(Job *job)
+{
+    return (ulong) job->start + process_deadline(job->process);
+}
+
+static void init(Engine *engine)
+{
+    engine->policy = heap_new();
+}
+
+static void destroy(Engine *engine)
+{
+    heap_destroy(engine->policy);
+}
+
+/**
+ * Ready jobs wait on a min-heap ordered by absolute deadline, with the
+ * earliest arrival first among ties.
+ */
+static void on_arrival(Engine *engine, Job *job)
+{
+    heap_push(engine->policy, deadline(job), job->seq, job);
+}
+
+/**
+ * The running job is preempted as soon as a job with an earlier deadline
+ * becomes ready.
+ */
+static bool on_event(Engine *engine, Job *running)
+{
+    ulong earliest;
+    heap_peek(engine->policy, &earliest, NULL);
+    return earliest < deadline(running);
+}
+
+static void on_preempt(Engine *engine, Job *job)
+{
+    on_arrival(engine, job);
+}
+
+static Job *pick_next(Engine *engine, Job *previous)
+{
+    return heap_pop(engine->policy);
+}
+
+static void run(Engine *engine);
+
+const Policy policy_edf = {
+    .title = "Earliest Deadline First",
+    .deadlines = true,
+    .init = init,
+    .destroy = destroy,
+    .on_arrival = on_arrival,
+    .on_event = on_event,
+    .on_preempt = on_preempt,
+    .pick_next = pick_next,
+    .run = run
+};
+
+ENGINE_SPECIALISE(run, policy_edf)
@@ -0,0 +1,392 @@
+#include <error.h>
+#include <engine.h>
+
+static void schedule_arrival(Engine *engine)
+{
+    uint arrival;
+    if (source_peek(engine->source, &arrival)) {
+        wheel_add(engine->wheel, &engine->arrival, arrival);
+    }
+}
+
+/**
+ * Appends a job to the ready jobs.
+ */
+static void link_job(Engine *engine, Job *job)
+{
+    job->prev = engine->tail;
+    job->next = NULL;
+    if (engine->tail) {
+        engine->tail->next = job;
+    }
+    else {
+        engine->head = job;
+    }
+    engine->tail = job;
+}
+
+static void unlink_job(Engine *engine, Job *job)
+{
+    if (job->prev) {
+        job->prev->next = job->next;
+    }
+    else {
+        engine->head = job->next;
+    }
+    if (job->next) {
+        job->next->prev = job->prev;
+    }
+    else {
+        engine->tail = job->prev;
+    }
+}
+
+/**
+ * Records the interval of time a job that has just stopped running ran for,
+ * if any time passed since the context switch to it.
+ */
+static void record_run(Engine *engine, Job *job, uint tick)
+{
+    if (engine->track && tick > job->since) {
+        track_add(engine->track, job->seq, job->since, tick);
+    }
+}
+
+/**
+ * Reports the results of a process. The turnaround of a process that didn't
+ * finish is reported as though it had finished at time 0.
+ */
+static void report_process(Engine *engine, size_t seq, Process *process,
+    uint wait, bool finished, uint tick)
+{
+    uint arrival = process_arrival(process);
+    uint turnaround = (finished ? tick : 0) - arrival;
+    report_set(engine->report, seq, process_name(process), wait, turnaround);
+    if (engine->track) {
+        track_name(engine->track, seq, process_name(process));
+    }
+
+    uint deadline = process_deadline(process);
+    if (deadline != PROCESS_NO_DEADLINE) {
+        long due = (long) arrival + deadline;
+        bool missed = finished ? tick > due : due <= engine->runfor;
+        report_set_deadline(engine->report, seq, finished, tick - due,
+            missed);
+    }
+}
+
+/**
+ * Reports a job, then hands its process back to the source and frees it.
+ */
+static void retire_job(Engine *engine, Job *job, uint wait, bool finished,
+    uint tick)
+{
+    report_process(engine, job->seq, job->process, wait, finished, tick);
+    engine->busy += job->ran + (job->length - job->burst);
+    source_release(engine->source, job->process);
+    free(job);
+}
+
+void engine_header(Engine *engine, const Policy *policy)
+{
+    output_printf(engine->out, "%zu processes\n",
+        source_count(engine->source));
+    output_printf(engine->out, "Using %s\n", policy->title);
+    if (engine->quantised) {
+        output_printf(engine->out, "Quantum %u\n", engine->quantum);
+    }
+    if (policy->aging && engine->aging) {
+        output_printf(engine->out, "Aging %u\n", engine->aging);
+    }
+    output_puts(engine->out, "\n");
+}
+
+void engine_start(Engine *engine, const Policy *policy)
+{
+    Source *source = engine->source;
+    if (engine->shared) {
+        engine->report = engine->shared;
+    }
+    else {
+        engine->report = report_new(source_count(source),
+            source_lazy(source), policy->deadlines);
+    }
+    engine->wheel = wheel_new(0);
+    engine->head = NULL;
+    engine->tail = NULL;
+    engine->running = NULL;
+    engine->tick = 0;
+    engine->policy = NULL;
+    engine->blocked = NULL;
+    engine->nblocked = 0;
+    engine->woken = NULL;
+    engine->nwoken = 0;
+    engine->capacity = 0;
+    engine->sorted = false;
+    engine->switches = 0;
+    engine->busy = 0;
+    engine->idle = 0;
+    engine->io = 0;
+    engine->overlap = 0;
+    engine->published = 0;
+    engine->events = 0;
+    engine->arrived = 0;
+    engine->finished = 0;
+    schedule_arrival(engine);
+
+    if (!engine->shared) {
+        engine_header(engine, policy);
+    }
+
+    if (policy->init) {
+        policy->init(engine);
+    }
+}
+
+void engine_stop(Engine *engine, const Policy *policy)
+{
+    uint runfor = engine->runfor;
+
+    if (engine->progress) {
+        engine_publish(engine, runfor);
+    }
+    if (!engine->shared) {
+        output_printf(engine->out, "Finished at time %u\n\n", runfor);
+    }
+
+    if (engine->running) {
+        job_sync(engine->running, runfor);
+        record_run(engine, engine->running, runfor);
+    }
+    while (engine->head) {
+        Job *job = engine->head;
+        unlink_job(engine, job);
+        retire_job(engine, job, runfor - job->start - job->served
+            - (job->length - job->burst), false, 0);
+    }
+    while (engine->blocked) {
+        Job *job = engine->blocked;
+        engine->blocked = job->next;
+        retire_job(engine, job, job->blocked - job->start - job->served,
+            false, 0);
+    }
+    Process *process;
+    size_t seq = source_seq(engine->source);
+    while ((process = source_next(engine->source))) {
+        report_process(engine, seq, process, 0, false, 0);
+        source_release(engine->source, process);
+        seq = source_seq(engine->source);
+    }
+    if (!engine->shared) {
+        if (engine->switchcost > 0 || engine->io > 0) {
+            Usage usage = {
+                .switches = engine->switches,
+                .overhead = runfor - engine->busy - engine->idle,
+                .busy = engine->busy,
+                .io = engine->io,
+                .overlap = engine->overlap,
+                .capacity = runfor
+            };
+            report_set_usage(engine->report, &usage);
+        }
+        report_print(engine->report, engine->out);
+    }
+
+    if (policy->destroy) {
+        policy->destroy(engine);
+    }
+    if (!engine->shared) {
+        report_destroy(engine->report);
+    }
+    wheel_destroy(engine->wheel);
+    free(engine->woken);
+}
+
+bool engine_next(Engine *engine, uint *tick)
+{
+    ulong due;
+    if (!wheel_next(engine->wheel, &due) || due > engine->runfor) {
+        return false;
+    }
+    *tick = due;
+    return true;
+}
+
+Job *engine_arrive(Engine *engine, uint tick)
+{
+    uint arrival;
+    while (source_peek(engine->source, &arrival) && arrival == tick) {
+        Job *job = amalloc(sizeof(Job));
+        job->seq = source_seq(engine->source);
+        job->process = source_next(engine->source);
+        ++engine->arrived;
+        job->name = process_name(job->process);
+        job->start = arrival;
+        job->length = process_burst(job->process);
+        job->burst = job->length;
+        job->ran = 0;
+        job->served = 0;
+        job->cycle = 0;
+        if (job->burst == 0) {
+            retire_job(engine, job, 0, false, 0);
+            continue;
+        }
+        link_job(engine, job);
+        return job;
+    }
+    schedule_arrival(engine);
+    return NULL;
+}
+
+void engine_dispatch(Engine *engine, Job *job, Job *previous, uint tick,
+    uint slice)
+{
+    ulong start = tick;
+    if (job != previous) {
+        ++engine->switches;
+        start += engine->switchcost;
+    }
+    job->dispatched = start < UINT_MAX ? start : UINT_MAX;
+    job->since = job->dispatched;
+    wheel_add(engine->wheel, &job->timer, start + slice);
+}
+
+void engine_preempt(Engine *engine, Job *job, uint tick, bool expired)
+{
+    if (!expired) {
+        wheel_cancel(engine->wheel, &job->timer);
+    }
+    record_run(engine, job, tick);
+}
+
+uint engine_block(Engine *engine, Job *job, uint tick)
+{
+    record_run(engine, job, tick);
+    unlink_job(engine, job);
+    job->prev = NULL;
+    job->next = engine->blocked;
+    if (engine->blocked) {
+        engine->blocked->prev = job;
+    }
+    engine->blocked = job;
+    ++engine->nblocked;
+
+    uint io = process_io(job->process, job->cycle);
+    job->ran += job->length;
+    job->served += job->length;
+    job->length = 0;
+    job->blocked = tick;
+    wheel_add(engine->wheel, &job->timer, (ulong) tick + io);
+    return io;
+}
+
+void engine_wake(Engine *engine, Job *job)
+{
+    if (engine->nwoken == engine->capacity) {
+        engine->capacity = engine->capacity ? 2 * engine->capacity : 16;
+        engine->woken = realloc(engine->woken,
+            engine->capacity * sizeof(Job *));
+        if (!engine->woken) {
+            error_abort("memory allocation failure");
+        }
+    }
+    engine->woken[engine->nwoken++] = job;
+}
+
+static int cmp_seq(const void *arg1, const void *arg2)
+{
+    const Job *job1 = *(Job *const *) arg1;
+    const Job *job2 = *(Job *const *) arg2;
+    return job1->seq < job2->seq ? 1 : job1->seq > job2->seq ? -1 : 0;
+}
+
+Job *engine_unblock(Engine *engine)
+{
+    if (engine->nwoken == 0) {
+        return NULL;
+    }
+    if (!engine->sorted) {
+        // Jobs are popped off the end, so the earliest arrival comes last
+        qsort(engine->woken, engine->nwoken, sizeof(Job *), cmp_seq);
+        engine->sorted = true;
+    }
+    Job *job = engine->woken[--engine->nwoken];
+    engine->sorted = engine->nwoken > 0;
+
+    if (job->prev) {
+        job->prev->next = job->next;
+    }
+    else {
+        engine->blocked = job->next;
+    }
+    if (job->next) {
+        job->next->prev = job->prev;
+    }
+    --engine->nblocked;
+
+    job->served += process_io(job->process, job->cycle);
+    job->length = process_cycle_burst(job->process, job->cycle++);
+    job->burst = job->length;
+    link_job(engine, job);
+    return job;
+}
+
+void engine_finish(Engine *engine, Job *job, uint tick)
+{
+    ++engine->finished;
+    record_run(engine, job, tick);
+    unlink_job(engine, job);
+    retire_job(engine, job, tick - job->start - job->served - job->length,
+        true, tick);
+}
+
+void engine_idle(Engine *engine, uint from, uint to)
+{
+    while (from < to) {
+        uint until = to;
+        if (engine->progress && to - from > ENGINE_PUBLISH_TICKS) {
+            until = from + ENGINE_PUBLISH_TICKS;
+        }
+        if (engine->shared) {
+            for (uint tick = from; tick < until; ++tick) {
+                output_printf(engine->out, "Time %u: group %u IDLE\n", tick,
+                    engine->group);
+            }
+        }
+        else {
+            for (uint tick = from; tick < until; ++tick) {
+                output_printf(engine->out, "Time %u: IDLE\n", tick);
+            }
+        }
+        if (until < to) {
+            engine_publish(engine, until);
+        }
+        from = until;
+    }
+}
+
+void engine_publish(Engine *engine, uint tick)
+{
+    Progress *progress = engine->progress;
+    progress_add(&progress->ticks, tick - engine->published);
+    progress_add(&progress->events, engine->events);
+    progress_add(&progress->arrived, engine->arrived);
+    progress_add(&progress->finished, engine->finished);
+    engine->published = tick;
+    engine->events = 0;
+    engine->arrived = 0;
+    engine->finished = 0;
+}
+
+void engine_run(Engine *engine, const Policy *policy)
+{
+    if (policy->run) {
+        policy->run(engine);
+    }
+    else if (engine->trace) {
+        engine_simulate(engine, policy, true);
+    }
+    else {
+        engine_simulate(engine, policy, false);
+    }
+}
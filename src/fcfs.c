@@ -0,0 +1,20 @@
+#include <engine.h>
+
+/**
+ * Jobs run to completion in the order they became ready, which is exactly the
+ * order the engine keeps ready jobs in.
+ */
+static Job *pick_next(Engine *engine, Job *previous)
+{
+    return engine->head;
+}
+
+static void run(Engine *engine);
+
+const Policy policy_fcfs = {
+    .title = "First Come First Served",
+    .pick_next = pick_next,
+    .run = run
+};
+
+ENGINE_SPECIALISE(run, policy_fcfs)
@@ -0,0 +1,95 @@
+#include <string.h>
+#include <error.h>
+#include <fenwick.h>
+
+struct Fenwick
+{
+    size_t size;
+    ulong *weights;
+    ulong *sums; // 1-indexed partial sums
+};
+
+/**
+ * Recomputes every partial sum from the weights in O(n).
+ */
+static void rebuild(Fenwick *tree)
+{
+    memset(tree->sums, 0, (tree->size + 1) * sizeof(ulong));
+    for (size_t i = 1; i <= tree->size; ++i) {
+        tree->sums[i] += tree->weights[i - 1];
+        size_t parent = i + (i & -i);
+        if (parent <= tree->size) {
+            tree->sums[parent] += tree->sums[i];
+        }
+    }
+}
+
+Fenwick *fenwick_new(size_t size)
+{
+    Fenwick *tree = amalloc(sizeof(Fenwick));
+    tree->size = size;
+    tree->weights = acalloc(size, sizeof(ulong));
+    tree->sums = acalloc(size + 1, sizeof(ulong));
+    return tree;
+}
+
+void fenwick_destroy(Fenwick *tree)
+{
+    if (!tree) {
+        return;
+    }
+    free(tree->weights);
+    free(tree->sums);
+    free(tree);
+}
+
+size_t fenwick_size(Fenwick *tree)
+{
+    return tree->size;
+}
+
+void fenwick_grow(Fenwick *tree, size_t size)
+{
+    ulong *weights = acalloc(size, sizeof(ulong));
+    memcpy(weights, tree->weights, tree->size * sizeof(ulong));
+    free(tree->weights);
+    free(tree->sums);
+    tree->size = size;
+    tree->weights = weights;
+    tree->sums = amalloc((size + 1) * sizeof(ulong));
+    rebuild(tree);
+}
+
+void fenwick_set(Fenwick *tree, size_t index, ulong weight)
+{
+    ulong old = tree->weights[index];
+    tree->weights[index] = weight;
+    for (size_t i = index + 1; i <= tree->size; i += i & -i) {
+        tree->sums[i] += weight - old;
+    }
+}
+
+ulong fenwick_total(Fenwick *tree)
+{
+    ulong total = 0;
+    for (size_t i = tree->size; i > 0; i -= i & -i) {
+        total += tree->sums[i];
+    }
+    return total;
+}
+
+size_t fenwick_find(Fenwick *tree, ulong total)
+{
+    size_t step = 1;
+    while (step * 2 <= tree->size) {
+        step *= 2;
+    }
+    size_t i = 0;
+    for (; step > 0; step /= 2) {
+        if (i + step <= tree->size && tree->sums[i + step] <= total) {
+            i += step;
+            total -= tree->sums[i];
+        }
+    }
+    return i;
+}
@@ -0,0 +1,112 @@
+#include <error.h>
+#include <heap.h>
+
+#define HEAP_CAPACITY_MIN 16
+
+typedef struct
+{
+    ulong key;
+    size_t seq;
+    void *item;
+} Node;
+
+struct Heap
+{
+    Node *nodes;
+    size_t capacity;
+    size_t size;
+};
+
+static bool less(const Node *node1, const Node *node2)
+{
+    if (node1->key != node2->key) {
+        return node1->key < node2->key;
+    }
+    return node1->seq < node2->seq;
+}
+
+Heap *heap_new()
+{
+    Heap *heap = amalloc(sizeof(Heap));
+    heap->nodes = amalloc(HEAP_CAPACITY_MIN * sizeof(Node));
+    heap->capacity = HEAP_CAPACITY_MIN;
+    heap->size = 0;
+    return heap;
+}
+
+void heap_destroy(Heap *heap)
+{
+    if (!heap) {
+        return;
+    }
+    free(heap->nodes);
+    free(heap);
+}
+
+size_t heap_size(Heap *heap)
+{
+    return heap->size;
+}
+
+void heap_push(Heap *heap, ulong key, size_t seq, void *item)
+{
+    if (heap->size == heap->capacity) {
+        heap->capacity *= 2;
+        heap->nodes = realloc(heap->nodes, heap->capacity * sizeof(Node));
+        if (!heap->nodes) {
+            error_abort("memory allocation failure");
+        }
+    }
+    Node node = { key, seq, item };
+    size_t i = heap->size++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!less(&node, &heap->nodes[parent])) {
+            break;
+        }
+        heap->nodes[i] = heap->nodes[parent];
+        i = parent;
+    }
+    heap->nodes[i] = node;
+}
+
+void *heap_peek(Heap *heap, ulong *key, size_t *seq)
+{
+    if (heap->size == 0) {
+        return NULL;
+    }
+    if (key) {
+        *key = heap->nodes[0].key;
+    }
+    if (seq) {
+        *seq = heap->nodes[0].seq;
+    }
+    return heap->nodes[0].item;
+}
+
+void *heap_pop(Heap *heap)
+{
+    if (heap->size == 0) {
+        return NULL;
+    }
+    void *item = heap->nodes[0].item;
+    Node last = heap->nodes[--heap->size];
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= heap->size) {
+            break;
+        }
+        if (child + 1 < heap->size
+            && less(&heap->nodes[child + 1], &heap->nodes[child])) {
+            ++child;
+        }
+        if (!less(&heap->nodes[child], &last)) {
+            break;
+        }
+        heap->nodes[i] = heap->nodes[child];
+        i = child;
+    }
+    heap->nodes[i] = last;
+    return item;
+}
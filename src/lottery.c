@@ -0,0 +1,110 @@
+#include <error.h>
+#include <fenwick.h>
+#include <random.h>
+#include <engine.h>
+
+/**
+ * The number of slots a lottery starts out with. The slots double whenever
+ * they run out.
+ */
+#define LOTTERY_SLOTS 64
+
+typedef struct Lottery
+{
+    Random random;
+    Fenwick *tickets; // tickets held by the job in each slot
+    Job **jobs;       // job in each slot
+    size_t *unused;   // stack of unused slots
+    size_t nunused;
+} Lottery;
+
+static void init(Engine *engine)
+{
+    Lottery *lottery = amalloc(sizeof(Lottery));
+    random_seed(&lottery->random, engine->seed);
+    lottery->tickets = fenwick_new(LOTTERY_SLOTS);
+    lottery->jobs = amalloc(LOTTERY_SLOTS * sizeof(Job *));
+    lottery->unused = amalloc(LOTTERY_SLOTS * sizeof(size_t));
+    for (size_t i = 0; i < LOTTERY_SLOTS; ++i) {
+        lottery->unused[i] = LOTTERY_SLOTS - 1 - i;
+    }
+    lottery->nunused = LOTTERY_SLOTS;
+    engine->policy = lottery;
+}
+
+static void destroy(Engine *engine)
+{
+    Lottery *lottery = engine->policy;
+    fenwick_destroy(lottery->tickets);
+    free(lottery->jobs);
+    free(lottery->unused);
+    free(lottery);
+}
+
+/**
+ * Doubles the number of slots.
+ */
+static void grow(Lottery *lottery)
+{
+    size_t size = fenwick_size(lottery->tickets);
+    fenwick_grow(lottery->tickets, 2 * size);
+    lottery->jobs = realloc(lottery->jobs, 2 * size * sizeof(Job *));
+    lottery->unused = realloc(lottery->unused, 2 * size * sizeof(size_t));
+    if (!lottery->jobs || !lottery->unused) {
+        error_abort("memory allocation failure");
+    }
+    for (size_t i = 0; i < size; ++i) {
+        lottery->unused[i] = 2 * size - 1 - i;
+    }
+    lottery->nunused = size;
+}
+
+/**
+ * Every ready job holds its tickets in a slot of a Fenwick tree, so that the
+ * winner of a draw is found in O(log n).
+ */
+static void on_arrival(Engine *engine, Job *job)
+{
+    Lottery *lottery = engine->policy;
+    if (lottery->nunused == 0) {
+        grow(lottery);
+    }
+    job->slot = lottery->unused[--lottery->nunused];
+    lottery->jobs[job->slot] = job;
+    fenwick_set(lottery->tickets, job->slot, process_tickets(job->process));
+}
+
+static void on_preempt(Engine *engine, Job *job)
+{
+    on_arrival(engine, job);
+}
+
+/**
+ * Draws a ticket uniformly at random among those held by ready jobs. The job
+ * holding it runs next.
+ */
+static Job *pick_next(Engine *engine, Job *previous)
+{
+    Lottery *lottery = engine->policy;
+    ulong total = fenwick_total(lottery->tickets);
+    ulong ticket = random_below(&lottery->random, total);
+    size_t slot = fenwick_find(lottery->tickets, ticket);
+    fenwick_set(lottery->tickets, slot, 0);
+    lottery->unused[lottery->nunused++] = slot;
+    return lottery->jobs[slot];
+}
+
+static void run(Engine *engine);
+
+const Policy policy_lottery = {
+    .title = "Lottery",
+    .init = init,
+    .destroy = destroy,
+    .on_arrival = on_arrival,
+    .on_preempt = on_preempt,
+    .pick_next = pick_next,
+    .slice = engine_quantum_slice,
+    .run = run
+};
+
+ENGINE_SPECIALISE(run, policy_lottery)
@@ -1,56 +1,174 @@
+#include <signal.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <unistd.h>
 #include <config.h>
 #include <error.h>
+#include <output.h>
+#include <progress.h>
+#include <source.h>
+#include <timeline.h>
+
+#define CONFIG_FILEPATH ("processes.in")
+#define OUTPUT_FILEPATH ("processes.out")
+#define USAGE ("usage: %s [-s] [-m] [-a] [-d] [-b bytes] [-p bytes] " \
+    "[-t timeline]")
 
 static Config *config = NULL;
+static Source *source = NULL;
+static Timeline *timeline = NULL;
+static Progress *progress = NULL;
+static FILE *cf = NULL;
 
-static void get_config(const char *filepath)
+static void get_config(const char *filepath, bool stream)
 {
-    FILE *cf = fopen(filepath, "r");
+    cf = fopen(filepath, "r");
     if (!cf) {
         error_exit("couldn't open %s", filepath);
     }
-    if (!config_load(&config, cf)) {
+    if (!config_load(&config, cf, stream)) {
         error_exit("line %u in %s", lineno, filepath);
     }
-    fclose(cf);
+    if (stream) {
+        source = source_stream(cf, config_processcount(config), filepath);
+    }
+    else {
+        fclose(cf);
+        cf = NULL;
+        source = source_list(config_processes(config));
+    }
+}
+
+/**
+ * Parses a byte count, optionally suffixed with K, M or G.
+ */
+static size_t get_size(const char *str, const char *program)
+{
+    char *end;
+    unsigned long long size = strtoull(str, &end, 10);
+    switch (*end) {
+        case 'G':
+            size <<= 10; // fall through
+        case 'M':
+            size <<= 10; // fall through
+        case 'K':
+            size <<= 10;
+            ++end;
+            break;
+    }
+    if (end == str || *end) {
+        error_exit(USAGE, program);
+    }
+    return size;
+}
+
+/**
+ * Withdraws published progress before dying of a signal, since atexit
+ * handlers don't run then.
+ */
+static void on_signal(int sig)
+{
+    progress_unlink();
+    raise(sig);
 }
 
 static void cleanup()
 {
+    progress_withdraw(progress);
+    timeline_destroy(timeline);
+    source_destroy(source);
     config_destroy(config);
+    if (cf) {
+        fclose(cf);
+    }
 }
 
-int main()
+int main(int argc, char *argv[])
 {
-    get_config("processes.in");
+    bool stream = false;
+    bool trace = true;
+    int flags = 0;
+    size_t buffer = OUTPUT_BUFFER_DEFAULT;
+    size_t preallocate = 0;
+    const char *timeline_filepath = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "smadb:p:t:")) != -1) {
+        switch (opt) {
+            case 's':
+                stream = true;
+                break;
+            case 'm':
+                trace = false;
+                break;
+            case 'a':
+                flags |= OUTPUT_ASYNC;
+                break;
+            case 'd':
+                flags |= OUTPUT_DIRECT;
+                break;
+            case 'b':
+                buffer = get_size(optarg, argv[0]);
+                break;
+            case 'p':
+                preallocate = get_size(optarg, argv[0]);
+                break;
+            case 't':
+                timeline_filepath = optarg;
+                break;
+            default:
+                error_exit(USAGE, argv[0]);
+        }
+    }
+
+    get_config(CONFIG_FILEPATH, stream);
 
     atexit(cleanup);
 
-    FILE *out = fopen("processes.out", "w");
+    if (timeline_filepath) {
+        // Streamed jobs are only made room for once they turn up
+        timeline = timeline_new(stream ? 0 : config_processcount(config));
+    }
+
+    // Progress is only for watching, so simulations go ahead without it
+    progress = progress_publish(config_runfor(config),
+        config_processcount(config));
+    if (progress) {
+        struct sigaction action = {
+            .sa_handler = on_signal,
+            .sa_flags = SA_RESETHAND
+        };
+        sigaction(SIGINT, &action, NULL);
+        sigaction(SIGTERM, &action, NULL);
+        sigaction(SIGHUP, &action, NULL);
+        sigaction(SIGABRT, &action, NULL);
+    }
+
+    Output *out = output_open(OUTPUT_FILEPATH, flags, buffer, preallocate);
     if (!out) {
         error_exit("couldn't create output file");
     }
-
-    uint runfor = config_runfor(config);
-    uint quantum = config_quantum(config);
-    ProcessList *processes = config_processes(config);
-    switch (config_use(config)) {
-        case SCHEDULER_RR:
-            run_rr(out, runfor, quantum, processes);
-            break;
-        case SCHEDULER_FCFS:
-            run_fcfs(out, runfor, processes);
-            break;
-        case SCHEDULER_SJF:
-            run_sjf(out, runfor, processes);
-            break;
-        default:
-            error_exit("unimplemented scheduler");
+    if (progress) {
+        output_progress(out, progress);
     }
 
-    fclose(out);
+    Settings settings = {
+        .runfor = config_runfor(config),
+        .quantum = config_quantum(config),
+        .seed = config_seed(config),
+        .switchcost = config_switchcost(config),
+        .aging = config_aging(config),
+        .trace = trace,
+        .timeline = timeline,
+        .progress = progress
+    };
+    scheduler_run(config_use(config), out, source, &settings);
+
+    output_close(out);
+
+    if (timeline && !timeline_write(timeline, timeline_filepath,
+        settings.runfor)) {
+        error_exit("couldn't write %s", timeline_filepath);
+    }
 
     exit(EXIT_SUCCESS);
 }
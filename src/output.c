@@ -0,0 +1,305 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <error.h>
+#include <output.h>
+
+#define OUTPUT_ALIGN 4096
+
+struct Output
+{
+    int fd;
+    int flags;
+    bool direct;
+    const char *filepath;
+    Progress *progress;
+    size_t size;
+    off_t length;
+    char *map;
+
+    // The buffer being filled by the caller
+    char *buffers[2];
+    char *current;
+    size_t used;
+
+    // The buffer handed to the writer thread, if any
+    pthread_t writer;
+    pthread_mutex_t lock;
+    pthread_cond_t filled;
+    pthread_cond_t drained;
+    char *pending;
+    size_t pending_used;
+    bool closing;
+};
+
+static void write_all(Output *out, const char *data, size_t size)
+{
+    while (size > 0) {
+        ssize_t n = write(out->fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error_exit("couldn't write %s: %s", out->filepath,
+                strerror(errno));
+        }
+        data += n;
+        size -= n;
+        if (out->progress) {
+            progress_add(&out->progress->written, n);
+        }
+    }
+}
+
+/**
+ * Writes a buffer to disk. Only the final buffer may be partially filled, in
+ * which case its unaligned tail is written without O_DIRECT.
+ */
+static void write_buffer(Output *out, const char *data, size_t size)
+{
+    if (out->direct && size % OUTPUT_ALIGN != 0) {
+        size_t aligned = size - size % OUTPUT_ALIGN;
+        write_all(out, data, aligned);
+        fcntl(out->fd, F_SETFL, fcntl(out->fd, F_GETFL) & ~O_DIRECT);
+        out->direct = false;
+        data += aligned;
+        size -= aligned;
+    }
+    write_all(out, data, size);
+}
+
+static void *writer_main(void *arg)
+{
+    Output *out = arg;
+    pthread_mutex_lock(&out->lock);
+    for (;;) {
+        while (!out->pending && !out->closing) {
+            pthread_cond_wait(&out->filled, &out->lock);
+        }
+        if (!out->pending) {
+            break;
+        }
+        char *data = out->pending;
+        size_t size = out->pending_used;
+        pthread_mutex_unlock(&out->lock);
+
+        write_buffer(out, data, size);
+
+        pthread_mutex_lock(&out->lock);
+        out->pending = NULL;
+        pthread_cond_signal(&out->drained);
+    }
+    pthread_mutex_unlock(&out->lock);
+    return NULL;
+}
+
+/**
+ * Hands the current buffer off to be written and starts filling the other.
+ */
+static void output_flush(Output *out)
+{
+    if (out->used == 0) {
+        return;
+    }
+    out->length += out->used;
+    if (!(out->flags & OUTPUT_ASYNC)) {
+        write_buffer(out, out->current, out->used);
+        out->used = 0;
+        return;
+    }
+    pthread_mutex_lock(&out->lock);
+    while (out->pending) {
+        pthread_cond_wait(&out->drained, &out->lock);
+    }
+    out->pending = out->current;
+    out->pending_used = out->used;
+    pthread_cond_signal(&out->filled);
+    pthread_mutex_unlock(&out->lock);
+
+    out->current = out->current == out->buffers[0]
+        ? out->buffers[1] : out->buffers[0];
+    out->used = 0;
+}
+
+static int open_file(const char *filepath, int flags)
+{
+    int oflags = O_WRONLY | O_CREAT | O_TRUNC;
+    if (flags & OUTPUT_DIRECT) {
+        int fd = open(filepath, oflags | O_DIRECT, 0644);
+        if (fd >= 0 || errno != EINVAL) {
+            return fd;
+        }
+    }
+    return open(filepath, oflags, 0644);
+}
+
+static char *buffer_new(size_t size)
+{
+    void *buffer = NULL;
+    if (posix_memalign(&buffer, OUTPUT_ALIGN, size) != 0) {
+        error_abort("memory allocation failure");
+    }
+    return buffer;
+}
+
+Output *output_open(const char *filepath, int flags, size_t buffer,
+    off_t preallocate)
+{
+    int fd = open_file(filepath, flags);
+    if (fd < 0) {
+        return NULL;
+    }
+    if (preallocate > 0) {
+        // Preallocation is best effort: file systems that don't support it,
+        // or lack the space, are written to normally
+        fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, preallocate);
+    }
+
+    Output *out = acalloc(1, sizeof(Output));
+    out->fd = fd;
+    out->flags = flags;
+    out->direct = fcntl(fd, F_GETFL) & O_DIRECT;
+    out->filepath = filepath;
+    out->size = buffer < OUTPUT_ALIGN ? OUTPUT_ALIGN
+        : (buffer + OUTPUT_ALIGN - 1) / OUTPUT_ALIGN * OUTPUT_ALIGN;
+    out->buffers[0] = buffer_new(out->size);
+    out->current = out->buffers[0];
+
+    if (flags & OUTPUT_ASYNC) {
+        out->buffers[1] = buffer_new(out->size);
+        pthread_mutex_init(&out->lock, NULL);
+        pthread_cond_init(&out->filled, NULL);
+        pthread_cond_init(&out->drained, NULL);
+        if (pthread_create(&out->writer, NULL, writer_main, out) != 0) {
+            error_abort("couldn't start writer thread");
+        }
+    }
+    return out;
+}
+
+Output *output_spool(size_t buffer)
+{
+    FILE *spool = tmpfile();
+    int fd = spool ? dup(fileno(spool)) : -1;
+    if (spool) {
+        fclose(spool);
+    }
+    if (fd < 0) {
+        error_exit("couldn't create output spool");
+    }
+
+    Output *out = acalloc(1, sizeof(Output));
+    out->fd = fd;
+    out->filepath = "output spool";
+    out->size = buffer < OUTPUT_ALIGN ? OUTPUT_ALIGN
+        : (buffer + OUTPUT_ALIGN - 1) / OUTPUT_ALIGN * OUTPUT_ALIGN;
+    out->buffers[0] = buffer_new(out->size);
+    out->current = out->buffers[0];
+    return out;
+}
+
+void output_progress(Output *out, Progress *progress)
+{
+    out->progress = progress;
+}
+
+const char *output_map(Output *out, size_t *length)
+{
+    output_flush(out);
+    *length = out->length;
+    if (out->length == 0) {
+        return NULL;
+    }
+    out->map = mmap(NULL, out->length, PROT_READ, MAP_PRIVATE, out->fd, 0);
+    if (out->map == MAP_FAILED) {
+        error_exit("couldn't map %s", out->filepath);
+    }
+    return out->map;
+}
+
+size_t output_tell(Output *out)
+{
+    return out->length + out->used;
+}
+
+void output_close(Output *out)
+{
+    if (!out) {
+        return;
+    }
+    output_flush(out);
+    if (out->flags & OUTPUT_ASYNC) {
+        pthread_mutex_lock(&out->lock);
+        out->closing = true;
+        pthread_cond_signal(&out->filled);
+        pthread_mutex_unlock(&out->lock);
+        pthread_join(out->writer, NULL);
+        pthread_mutex_destroy(&out->lock);
+        pthread_cond_destroy(&out->filled);
+        pthread_cond_destroy(&out->drained);
+    }
+    if (ftruncate(out->fd, out->length) != 0) {
+        error_exit("couldn't truncate %s", out->filepath);
+    }
+    if (out->map) {
+        munmap(out->map, out->length);
+    }
+    close(out->fd);
+    free(out->buffers[0]);
+    free(out->buffers[1]);
+    free(out);
+}
+
+/**
+ * Fills every buffer to the brim before handing it off so that only the final
+ * buffer written can be partially filled.
+ */
+void output_write(Output *out, const char *data, size_t size)
+{
+    while (size > 0) {
+        if (out->used == out->size) {
+            output_flush(out);
+        }
+        size_t n = out->size - out->used;
+        n = size < n ? size : n;
+        memcpy(out->current + out->used, data, n);
+        out->used += n;
+        data += n;
+        size -= n;
+    }
+}
+
+void output_printf(Output *out, const char *format, ...)
+{
+    size_t space = out->size - out->used;
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(out->current + out->used, space, format, args);
+    va_end(args);
+    if (length < 0) {
+        error_abort("couldn't format output");
+    }
+    if ((size_t) length < space) {
+        out->used += length;
+        return;
+    }
+
+    // The text straddles two buffers, so format it again on the side
+    char *text = amalloc(length + 1);
+    va_start(args, format);
+    vsnprintf(text, length + 1, format, args);
+    va_end(args);
+    output_write(out, text, length);
+    free(text);
+}
+
+void output_puts(Output *out, const char *str)
+{
+    output_write(out, str, strlen(str));
+}
@@ -0,0 +1,228 @@
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <error.h>
+#include <heap.h>
+#include <partition.h>
+
+typedef struct
+{
+    Source *source;
+    Track *track;
+    const char *text; // spooled events yet to be merged
+    const char *stop;
+    size_t worker;    // worker whose spool holds the events
+    size_t begin;     // position of the events within the spool
+    size_t end;
+    size_t switches;
+    ulong busy;
+    ulong idle;
+    ulong io;
+    ulong overlap;
+} Part;
+
+typedef struct
+{
+    const Engine *engine;
+    const Policy *policy;
+    Report *report;
+    Part *parts;
+    size_t count;
+    size_t next; // next part to be simulated, claimed atomically
+} Partition;
+
+typedef struct
+{
+    Partition *partition;
+    size_t index;
+    Output *spool;
+    const char *text; // the spool, mapped once every part has been simulated
+    pthread_t thread;
+} Worker;
+
+/**
+ * Simulates parts until none are left to claim.
+ */
+static void *worker_main(void *arg)
+{
+    Worker *worker = arg;
+    Partition *partition = worker->partition;
+    for (;;) {
+        size_t i = __atomic_fetch_add(&partition->next, 1, __ATOMIC_RELAXED);
+        if (i >= partition->count) {
+            break;
+        }
+        Part *part = &partition->parts[i];
+        uint group = source_group(part->source);
+
+        // Each part draws from a generator of its own
+        Engine engine = *partition->engine;
+        engine.out = worker->spool;
+        engine.source = part->source;
+        engine.seed += group;
+        engine.shared = partition->report;
+        engine.group = group;
+        engine.track = part->track;
+
+        part->worker = worker->index;
+        part->begin = worker->spool ? output_tell(worker->spool) : 0;
+        engine_run(&engine, partition->policy);
+        part->end = worker->spool ? output_tell(worker->spool) : 0;
+        part->switches = engine.switches;
+        part->busy = engine.busy;
+        part->idle = engine.idle;
+        part->io = engine.io;
+        part->overlap = engine.overlap;
+    }
+    return NULL;
+}
+
+/**
+ * @return The time of the event at the start of a line
+ */
+static ulong line_time(const char *line)
+{
+    return strtoul(line + strlen("Time "), NULL, 10);
+}
+
+static const char *line_end(const char *line, const char *stop)
+{
+    return (const char *) memchr(line, '\n', stop - line) + 1;
+}
+
+/**
+ * Merges the spooled events of every part by time. Whichever part holds the
+ * earliest event outputs every event preceding the earliest event of any
+ * other part in one go.
+ */
+static void merge(Partition *partition, Worker *workers, Output *out)
+{
+    Heap *heap = heap_new();
+    for (Worker *worker = workers; worker->partition; ++worker) {
+        size_t length;
+        worker->text = output_map(worker->spool, &length);
+    }
+    for (size_t i = 0; i < partition->count; ++i) {
+        Part *part = &partition->parts[i];
+        if (part->begin == part->end) {
+            continue;
+        }
+        const char *text = workers[part->worker].text;
+        part->text = text + part->begin;
+        part->stop = text + part->end;
+        heap_push(heap, line_time(part->text), i, part);
+    }
+
+    while (heap_size(heap) > 0) {
+        Part *part = heap_pop(heap);
+        size_t index = part - partition->parts;
+        ulong key = ULONG_MAX;
+        size_t seq = 0;
+        heap_peek(heap, &key, &seq);
+
+        const char *line = part->text;
+        ulong time = 0;
+        do {
+            line = line_end(line, part->stop);
+        } while (line < part->stop && ((time = line_time(line)) < key
+            || (time == key && index < seq)));
+        output_write(out, part->text, line - part->text);
+
+        part->text = line;
+        if (line < part->stop) {
+            heap_push(heap, time, index, part);
+        }
+    }
+    heap_destroy(heap);
+}
+
+/**
+ * Sums up how the CPU of every part was used.
+ */
+static void record_usage(Partition *partition)
+{
+    Usage usage = {
+        .capacity = (ulong) partition->engine->runfor * partition->count
+    };
+    ulong idle = 0;
+    for (size_t i = 0; i < partition->count; ++i) {
+        Part *part = &partition->parts[i];
+        usage.switches += part->switches;
+        usage.busy += part->busy;
+        usage.io += part->io;
+        usage.overlap += part->overlap;
+        idle += part->idle;
+    }
+    usage.overhead = usage.capacity - usage.busy - idle;
+    if (partition->engine->switchcost > 0 || usage.io > 0) {
+        report_set_usage(partition->report, &usage);
+    }
+}
+
+bool partition_run(Engine *engine, const Policy *policy)
+{
+    Source *source = engine->source;
+    size_t count;
+    Source **sources = source_split(source, &count);
+    if (!sources) {
+        return false;
+    }
+
+    Partition partition = {
+        .engine = engine,
+        .policy = policy,
+        .report = report_new(source_count(source), false, policy->deadlines),
+        .parts = acalloc(count, sizeof(Part)),
+        .count = count
+    };
+    for (size_t i = 0; i < count; ++i) {
+        partition.parts[i].source = sources[i];
+        if (engine->timeline) {
+            partition.parts[i].track = timeline_track(engine->timeline,
+                source_group(sources[i]));
+        }
+    }
+    if (engine->progress) {
+        progress_store(&engine->progress->cpus, count);
+    }
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t nworkers = cpus < 1 ? 1 : (size_t) cpus < count ? cpus : count;
+    Worker *workers = acalloc(nworkers + 1, sizeof(Worker)); // terminated
+    for (size_t i = 0; i < nworkers; ++i) {
+        workers[i].partition = &partition;
+        workers[i].index = i;
+        if (engine->trace) {
+            workers[i].spool = output_spool(OUTPUT_BUFFER_DEFAULT);
+        }
+        if (pthread_create(&workers[i].thread, NULL, worker_main,
+            &workers[i]) != 0) {
+            error_abort("couldn't start worker thread");
+        }
+    }
+    for (size_t i = 0; i < nworkers; ++i) {
+        pthread_join(workers[i].thread, NULL);
+    }
+
+    engine_header(engine, policy);
+    if (engine->trace) {
+        merge(&partition, workers, engine->out);
+    }
+    output_printf(engine->out, "Finished at time %u\n\n", engine->runfor);
+    record_usage(&partition);
+    report_print(partition.report, engine->out);
+
+    for (size_t i = 0; i < nworkers; ++i) {
+        output_close(workers[i].spool);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        source_destroy(sources[i]);
+    }
+    free(workers);
+    free(sources);
+    free(partition.parts);
+    report_destroy(partition.report);
+    return true;
+}
@@ -0,0 +1,147 @@
+#include <string.h>
+#include <error.h>
+#include <engine.h>
+
+_Static_assert(PROCESS_PRIORITY_LEVELS <= 64,
+    "every priority level needs a bit of the occupancy bitmap");
+
+/**
+ * The jobs of one priority level in the order they became ready, held in a
+ * ring buffer whose capacity is a power of 2.
+ */
+typedef struct Bucket
+{
+    Job **jobs;
+    size_t first;
+    size_t count;
+    size_t capacity;
+} Bucket;
+
+typedef struct Priority
+{
+    Bucket buckets[PROCESS_PRIORITY_LEVELS];
+    unsigned long long occupied; // bit i is set if bucket i holds any jobs
+    size_t order;                // jobs made ready so far
+} Priority;
+
+static void bucket_push(Bucket *bucket, Job *job)
+{
+    if (bucket->count == bucket->capacity) {
+        size_t capacity = bucket->capacity ? 2 * bucket->capacity : 16;
+        Job **jobs = amalloc(capacity * sizeof(Job *));
+        if (bucket->count > 0) {
+            // Unwrap the full ring to the front of the new buffer
+            size_t head = bucket->capacity - bucket->first;
+            memcpy(jobs, bucket->jobs + bucket->first, head * sizeof(Job *));
+            memcpy(jobs + head, bucket->jobs, bucket->first * sizeof(Job *));
+        }
+        free(bucket->jobs);
+        bucket->jobs = jobs;
+        bucket->first = 0;
+        bucket->capacity = capacity;
+    }
+    size_t last = (bucket->first + bucket->count) & (bucket->capacity - 1);
+    bucket->jobs[last] = job;
+    ++bucket->count;
+}
+
+static Job *bucket_pop(Bucket *bucket)
+{
+    Job *job = bucket->jobs[bucket->first];
+    bucket->first = (bucket->first + 1) & (bucket->capacity - 1);
+    --bucket->count;
+    return job;
+}
+
+static void init(Engine *engine)
+{
+    engine->policy = acalloc(1, sizeof(Priority));
+}
+
+static void destroy(Engine *engine)
+{
+    Priority *policy = engine->policy;
+    for (size_t i = 0; i < PROCESS_PRIORITY_LEVELS; ++i) {
+        free(policy->buckets[i].jobs);
+    }
+    free(policy);
+}
+
+/**
+ * Ready jobs wait in a bucket per priority level, in the order they became
+ * ready. The time a job became ready is its key, from which its aging is
+ * worked out whenever it is needed rather than on every tick.
+ */
+static void on_arrival(Engine *engine, Job *job)
+{
+    Priority *policy = engine->policy;
+    uint level = process_priority(job->process);
+    job->key = engine->tick;
+    job->slot = policy->order++;
+    bucket_push(&policy->buckets[level], job);
+    policy->occupied |= 1ULL << level;
+}
+
+/**
+ * A job's priority rises by one level for every so many ticks it has waited
+ * since it became ready, up to the highest priority.
+ *
+ * @return The priority a job waiting in a bucket has aged to
+ */
+static uint effective(Engine *engine, Job *job, uint level)
+{
+    ulong raised = (engine->tick - job->key) / engine->aging;
+    return raised < level ? level - raised : 0;
+}
+
+/**
+ * Runs the job of highest priority, once aged, with the job that became
+ * ready first among ties. Within a bucket, the job that became ready first
+ * has aged the most, so only the front of each bucket is a candidate, and
+ * the bitmap gives the buckets worth looking at without visiting every level.
+ * Without aging, the front of the first occupied bucket is the job to run.
+ */
+static Job *pick_next(Engine *engine, Job *previous)
+{
+    Priority *policy = engine->policy;
+    unsigned long long occupied = policy->occupied;
+    uint best = __builtin_ctzll(occupied);
+    if (engine->aging) {
+        Job *chosen = policy->buckets[best].jobs[policy->buckets[best].first];
+        uint highest = effective(engine, chosen, best);
+        occupied &= occupied - 1;
+        while (occupied) {
+            uint level = __builtin_ctzll(occupied);
+            Bucket *bucket = &policy->buckets[level];
+            Job *job = bucket->jobs[bucket->first];
+            uint priority = effective(engine, job, level);
+            if (priority < highest
+                || (priority == highest && job->slot < chosen->slot)) {
+                chosen = job;
+                highest = priority;
+                best = level;
+            }
+            occupied &= occupied - 1;
+        }
+    }
+    Bucket *bucket = &policy->buckets[best];
+    Job *job = bucket_pop(bucket);
+    if (bucket->count == 0) {
+        policy->occupied &= ~(1ULL << best);
+    }
+    return job;
+}
+
+static void run(Engine *engine);
+
+const Policy policy_priority = {
+    .title = "Priority",
+    .aging = true,
+    .init = init,
+    .destroy = destroy,
+    .on_arrival = on_arrival,
+    .pick_next = pick_next,
+    .run = run
+};
+
+ENGINE_SPECIALISE(run, policy_priority)
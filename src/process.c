@@ -4,11 +4,23 @@
 
 // #region Process -------------------------------------------------------------
 
+typedef struct
+{
+    uint io;
+    uint burst;
+} Cycle;
+
 struct Process
 {
     char *name;
     uint arrival;
     uint burst;
+    uint deadline;
+    uint tickets;
+    uint priority;
+    uint group;
+    Cycle *cycles; // I/O bursts, each followed by a CPU burst
+    size_t ncycles;
 };
 
 Process *process_new(char *name, uint arrival, uint burst)
@@ -18,6 +30,12 @@ Process *process_new(char *name, uint arrival, uint burst)
     strcpy(p->name, name);
     p->arrival = arrival;
     p->burst = burst;
+    p->deadline = PROCESS_NO_DEADLINE;
+    p->tickets = PROCESS_TICKETS_DEFAULT;
+    p->priority = 0;
+    p->group = 0;
+    p->cycles = NULL;
+    p->ncycles = 0;
     return p;
 }
 
@@ -27,6 +45,7 @@ void process_destroy(Process *process)
         return;
     }
     free(process->name);
+    free(process->cycles);
     free(process);
 }
 
@@ -45,6 +64,76 @@ uint process_arrival(Process *process)
     return process->arrival;
 }
 
+uint process_deadline(Process *process)
+{
+    return process->deadline;
+}
+
+void process_set_deadline(Process *process, uint deadline)
+{
+    process->deadline = deadline;
+}
+
+uint process_tickets(Process *process)
+{
+    return process->tickets;
+}
+
+void process_set_tickets(Process *process, uint tickets)
+{
+    process->tickets = tickets;
+}
+
+uint process_priority(Process *process)
+{
+    return process->priority;
+}
+
+void process_set_priority(Process *process, uint priority)
+{
+    process->priority = priority;
+}
+
+uint process_group(Process *process)
+{
+    return process->group;
+}
+
+void process_set_group(Process *process, uint group)
+{
+    process->group = group;
+}
+
+size_t process_cycles(Process *process)
+{
+    return process->ncycles;
+}
+
+uint process_io(Process *process, size_t cycle)
+{
+    return process->cycles[cycle].io;
+}
+
+uint process_cycle_burst(Process *process, size_t cycle)
+{
+    return process->cycles[cycle].burst;
+}
+
+void process_add_cycle(Process *process, uint io, uint burst)
+{
+    size_t n = process->ncycles;
+    if ((n & (n - 1)) == 0) {
+        // Double the capacity whenever the number of cycles is a power of 2
+        process->cycles = realloc(process->cycles,
+            (n ? 2 * n : 1) * sizeof(Cycle));
+        if (!process->cycles) {
+            error_abort("memory allocation failure");
+        }
+    }
+    process->cycles[n] = (Cycle) { io, burst };
+    process->ncycles = n + 1;
+}
+
 // #endregion ------------------------------------------------------------------
 
 // #region ProcessList ---------------------------------------------------------
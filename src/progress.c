@@ -0,0 +1,106 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <progress.h>
+
+/**
+ * The name of the progress published by the calling process, if any, kept
+ * ready for signal handlers.
+ */
+static char published[64];
+
+/**
+ * Names the shared memory a process publishes its progress to.
+ */
+static void progress_name(char *name, size_t size, pid_t pid)
+{
+    snprintf(name, size, "/%s%ld", PROGRESS_PREFIX, (long) pid);
+}
+
+Progress *progress_publish(uint runfor, size_t processes)
+{
+    char name[sizeof(published)];
+    progress_name(name, sizeof(name), getpid());
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return NULL;
+    }
+    Progress *progress = MAP_FAILED;
+    if (ftruncate(fd, sizeof(Progress)) == 0) {
+        progress = mmap(NULL, sizeof(Progress), PROT_READ | PROT_WRITE,
+            MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (progress == MAP_FAILED) {
+        shm_unlink(name);
+        return NULL;
+    }
+    progress->pid = getpid();
+    progress->runfor = runfor;
+    progress->cpus = 1;
+    progress->processes = processes;
+    // Readers only trust the rest once the magic is in place
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(progress->magic, PROGRESS_MAGIC, sizeof(progress->magic));
+    memcpy(published, name, sizeof(published));
+    return progress;
+}
+
+void progress_withdraw(Progress *progress)
+{
+    if (!progress) {
+        return;
+    }
+    munmap(progress, sizeof(Progress));
+    progress_unlink();
+}
+
+void progress_unlink(void)
+{
+    if (published[0]) {
+        shm_unlink(published);
+        published[0] = '\0';
+    }
+}
+
+bool progress_remove(pid_t pid)
+{
+    char name[64];
+    progress_name(name, sizeof(name), pid);
+    return shm_unlink(name) == 0;
+}
+
+const Progress *progress_attach(pid_t pid)
+{
+    char name[64];
+    progress_name(name, sizeof(name), pid);
+    int fd = shm_open(name, O_RDONLY, 0);
+    struct stat st;
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(Progress)) {
+        close(fd);
+        return NULL;
+    }
+    const Progress *progress = mmap(NULL, sizeof(Progress), PROT_READ,
+        MAP_SHARED, fd, 0);
+    close(fd);
+    if (progress == MAP_FAILED) {
+        return NULL;
+    }
+    if (memcmp(progress->magic, PROGRESS_MAGIC, sizeof(progress->magic))
+        != 0) {
+        progress_detach(progress);
+        return NULL;
+    }
+    return progress;
+}
+
+void progress_detach(const Progress *progress)
+{
+    munmap((void *) progress, sizeof(Progress));
+}
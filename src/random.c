@@ -0,0 +1,47 @@
+#include <random.h>
+
+static unsigned long long rotl(unsigned long long x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * Expands the seed with splitmix64, so that similar seeds still yield
+ * unrelated sequences.
+ */
+void random_seed(Random *random, ulong seed)
+{
+    unsigned long long x = seed;
+    for (int i = 0; i < 4; ++i) {
+        unsigned long long z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        random->state[i] = z ^ (z >> 31);
+    }
+}
+
+unsigned long long random_next(Random *random)
+{
+    unsigned long long *s = random->state;
+    unsigned long long result = rotl(s[1] * 5, 7) * 9;
+    unsigned long long t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+ulong random_below(Random *random, ulong bound)
+{
+    // Rejects the values that would make some results likelier than others
+    unsigned long long limit = -(unsigned long long) bound % bound;
+    unsigned long long x;
+    do {
+        x = random_next(random);
+    }
+    while (x < limit);
+    return x % bound;
+}
@@ -6,6 +6,14 @@
 
 ulong lineno;
 
+/**
+ * The most recently read line. The buffer is reused from one line to the next.
+ * Should a line be unread, the next read is handed the same line again.
+ */
+static char *line = NULL;
+static size_t line_capacity = 0;
+static bool line_unread = false;
+
 typedef struct
 {
     const char * const string;
@@ -32,24 +40,26 @@ static bool is_whitespace(const char *str)
     return true;
 }
 
-static bool get_next_line(char **line, FILE *stream)
+static bool get_next_line(FILE *stream)
 {
+    if (line_unread) {
+        line_unread = false;
+        return true;
+    }
     do {
-        size_t size;
-        ssize_t length = getline(line, &size, stream);
+        ssize_t length = getline(&line, &line_capacity, stream);
         if (length == -1) {
             return false;
         }
-        strip_comment(*line);
+        strip_comment(line);
     }
-    while (is_whitespace(*line));
+    while (is_whitespace(line));
     return true;
 }
 
 static bool scanf_line(FILE *stream, Format *fmt, ...)
 {
-    char *line = NULL;
-    if (!get_next_line(&line, stream)) {
+    if (!get_next_line(stream)) {
         return false;
     }
     va_list arg;
@@ -79,26 +89,12 @@ bool read_runfor(uint *result, FILE *stream)
     return false;
 }
 
-static SchedulerType to_schedulertype(const char *str)
-{
-    if (strcmp(str, "fcfs") == 0) {
-        return SCHEDULER_FCFS;
-    }
-    else if (strcmp(str, "rr") == 0) {
-        return SCHEDULER_RR;
-    }
-    else if (strcmp(str, "sjf") == 0) {
-        return SCHEDULER_SJF;
-    }
-    return SCHEDULER_UNDEF;
-}
-
 bool read_use(SchedulerType *result, FILE *stream)
 {
-    Format fmt = { "use %5s", 1 };
-    char use[6];
+    Format fmt = { "use %15s", 1 };
+    char use[16];
     if (scanf_line(stream, &fmt, &use)) {
-        *result = to_schedulertype(use);
+        *result = scheduler_type(use);
         if (*result != SCHEDULER_UNDEF) {
             ++lineno;
             return true;
@@ -107,6 +103,23 @@ bool read_use(SchedulerType *result, FILE *stream)
     return false;
 }
 
+bool read_setting(const char *name, uint *result, FILE *stream)
+{
+    if (!get_next_line(stream)) {
+        return false;
+    }
+    char setting[16];
+    uint value;
+    if (sscanf(line, "%15s %u", setting, &value) != 2
+        || strcmp(setting, name) != 0) {
+        line_unread = true;
+        return false;
+    }
+    *result = value;
+    ++lineno;
+    return true;
+}
+
 bool read_quantum(uint *result, FILE *stream)
 {
     Format fmt = { "quantum %u", 1 };
@@ -117,16 +130,75 @@ bool read_quantum(uint *result, FILE *stream)
     return false;
 }
 
-static bool read_process(Process **result, FILE *stream)
+static bool is_blank(const char *str)
 {
-    Format fmt = { "process name %20s arrival %u burst %u", 3 };
+    while (isspace(*str)) {
+        ++str;
+    }
+    return *str == '\0';
+}
+
+/**
+ * Parses the optional attributes trailing a process line, each of which is a
+ * name followed by a value. Every I/O burst must be followed by a CPU burst,
+ * and may only follow a process's first CPU burst if that isn't empty, as a
+ * process with nothing to run is done as soon as it arrives.
+ */
+static bool read_attributes(Process *process, const char *str)
+{
+    char attribute[16];
+    uint value;
+    int length;
+    uint io = 0; // I/O burst awaiting the CPU burst that follows it
+    while (sscanf(str, " %15s %u%n", attribute, &value, &length) == 2) {
+        if (io > 0) {
+            if (strcmp(attribute, "burst") != 0 || value == 0) {
+                return false;
+            }
+            process_add_cycle(process, io, value);
+            io = 0;
+        }
+        else if (strcmp(attribute, "io") == 0 && value > 0
+            && process_burst(process) > 0) {
+            io = value;
+        }
+        else if (strcmp(attribute, "deadline") == 0) {
+            process_set_deadline(process, value);
+        }
+        else if (strcmp(attribute, "tickets") == 0 && value > 0) {
+            process_set_tickets(process, value);
+        }
+        else if (strcmp(attribute, "priority") == 0
+            && value < PROCESS_PRIORITY_LEVELS) {
+            process_set_priority(process, value);
+        }
+        else if (strcmp(attribute, "group") == 0) {
+            process_set_group(process, value);
+        }
+        else {
+            return false;
+        }
+        str += length;
+    }
+    return io == 0 && is_blank(str);
+}
+
+bool read_process(Process **result, FILE *stream)
+{
+    Format fmt = { "process name %20s arrival %u burst %u%n", 3 };
     char name[21];
     uint arrival = 0;
     uint burst = 0;
-    if (!scanf_line(stream, &fmt, &name, &arrival, &burst)) {
+    int length = 0;
+    if (!scanf_line(stream, &fmt, &name, &arrival, &burst, &length)) {
+        return false;
+    }
+    Process *process = process_new(name, arrival, burst);
+    if (!read_attributes(process, line + length)) {
+        process_destroy(process);
         return false;
     }
-    *result = process_new(name, arrival, burst);
+    *result = process;
     ++lineno;
     return true;
 }
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <error.h>
+#include <process.h>
+#include <report.h>
+
+typedef enum RecordFlags {
+    RECORD_DEADLINE = 1 << 0, // the job had a deadline
+    RECORD_FINISHED = 1 << 1, // the job finished, so its lateness is known
+    RECORD_MISSED = 1 << 2    // the job missed its deadline
+} RecordFlags;
+
+typedef struct
+{
+    char name[PROCESS_NAME_MAX + 1];
+    unsigned char flags;
+    uint wait;
+    uint turnaround;
+    long lateness;
+} Record;
+
+struct Report
+{
+    size_t count;
+    bool deadlines;
+    Record *records;
+    FILE *spool;
+
+    bool usage;
+    Usage cpu;
+};
+
+/**
+ * Maps a temporary file large enough to hold every record, so that records can
+ * be written in any order without a system call each, and left for the kernel
+ * to write back rather than being held in memory.
+ */
+static void spool_map(Report *report)
+{
+    size_t size = report->count * sizeof(Record);
+    report->spool = tmpfile();
+    if (!report->spool || ftruncate(fileno(report->spool), size) != 0) {
+        error_exit("couldn't create report spool");
+    }
+    report->records = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+        fileno(report->spool), 0);
+    if (report->records == MAP_FAILED) {
+        error_exit("couldn't map report spool");
+    }
+}
+
+Report *report_new(size_t count, bool spool, bool deadlines)
+{
+    Report *report = acalloc(1, sizeof(Report));
+    report->count = count;
+    report->deadlines = deadlines;
+    if (spool && count > 0) {
+        spool_map(report);
+    }
+    else {
+        report->records = acalloc(count, sizeof(Record));
+    }
+    return report;
+}
+
+void report_destroy(Report *report)
+{
+    if (!report) {
+        return;
+    }
+    if (report->spool) {
+        munmap(report->records, report->count * sizeof(Record));
+        fclose(report->spool);
+    }
+    else {
+        free(report->records);
+    }
+    free(report);
+}
+
+void report_set(Report *report, size_t seq, const char *name, uint wait,
+    uint turnaround)
+{
+    Record record = { .wait = wait, .turnaround = turnaround };
+    strncpy(record.name, name, PROCESS_NAME_MAX);
+    report->records[seq] = record;
+}
+
+void report_set_deadline(Report *report, size_t seq, bool finished,
+    long lateness, bool missed)
+{
+    Record *record = &report->records[seq];
+    record->flags = RECORD_DEADLINE;
+    if (finished) {
+        record->flags |= RECORD_FINISHED;
+        record->lateness = lateness;
+    }
+    if (missed) {
+        record->flags |= RECORD_MISSED;
+    }
+}
+
+void report_set_usage(Report *report, const Usage *usage)
+{
+    report->usage = true;
+    report->cpu = *usage;
+}
+
+static void print_deadline(Output *out, const Record *record)
+{
+    if (record->flags & RECORD_FINISHED) {
+        output_printf(out, " lateness %ld", record->lateness);
+    }
+    else {
+        output_puts(out, " lateness -");
+    }
+    output_printf(out, " missed %s\n",
+        record->flags & RECORD_MISSED ? "yes" : "no");
+}
+
+void report_print(Report *report, Output *out)
+{
+    size_t deadlines = 0, missed = 0;
+    for (size_t i = 0; i < report->count; ++i) {
+        const Record *record = &report->records[i];
+        if (!report->deadlines) {
+            output_printf(out, "%s wait %u turnaround %u\n", record->name,
+                record->wait, record->turnaround);
+            continue;
+        }
+        output_printf(out, "%s wait %u turnaround %u", record->name,
+            record->wait, record->turnaround);
+        print_deadline(out, record);
+        deadlines += (record->flags & RECORD_DEADLINE) != 0;
+        missed += (record->flags & RECORD_MISSED) != 0;
+    }
+    if (report->deadlines) {
+        output_printf(out, "\nMissed %zu of %zu deadlines (%.2f%%)\n", missed,
+            deadlines, deadlines ? 100.0 * missed / deadlines : 0.0);
+    }
+    if (report->usage) {
+        const Usage *cpu = &report->cpu;
+        output_printf(out, "\n%zu context switches (%lu ticks of overhead)\n",
+            cpu->switches, cpu->overhead);
+        output_printf(out, "CPU utilisation %.2f%%\n", cpu->capacity
+            ? 100.0 * cpu->busy / cpu->capacity : 0.0);
+        if (cpu->io > 0) {
+            output_printf(out, "I/O overlap %lu of %lu ticks (%.2f%%)\n",
+                cpu->overlap, cpu->io, 100.0 * cpu->overlap / cpu->io);
+        }
+    }
+}
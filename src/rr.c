@@ -0,0 +1,23 @@
+#include <engine.h>
+
+/**
+ * Jobs take turns in the order they became ready, so jobs returning from I/O
+ * join the back of the line. Once a job's quantum expires, the job that
+ * became ready after it runs next, wrapping around to the front of the line.
+ * Once a job finishes or blocks, the front of the line runs next.
+ */
+static Job *pick_next(Engine *engine, Job *previous)
+{
+    return previous && previous->next ? previous->next : engine->head;
+}
+
+static void run(Engine *engine);
+
+const Policy policy_rr = {
+    .title = "Round-Robin",
+    .pick_next = pick_next,
+    .slice = engine_quantum_slice,
+    .run = run
+};
+
+ENGINE_SPECIALISE(run, policy_rr)
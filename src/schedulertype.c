@@ -0,0 +1,41 @@
+#include <string.h>
+#include <schedulertype.h>
+
+/**
+ * What a configuration needs to know about each scheduler, kept apart from
+ * the schedulers themselves so that tools writing configurations can do
+ * without the simulator.
+ */
+static const struct
+{
+    const char *name;
+    bool quantum;
+} types[] = {
+    [SCHEDULER_FCFS] = { "fcfs", false },
+    [SCHEDULER_SJF] = { "sjf", false },
+    [SCHEDULER_RR] = { "rr", true },
+    [SCHEDULER_EDF] = { "edf", false },
+    [SCHEDULER_STRIDE] = { "stride", true },
+    [SCHEDULER_LOTTERY] = { "lottery", true },
+    [SCHEDULER_PRIORITY] = { "priority", false }
+};
+
+const char *scheduler_name(SchedulerType type)
+{
+    return types[type].name;
+}
+
+bool scheduler_quantum(SchedulerType type)
+{
+    return types[type].quantum;
+}
+
+SchedulerType scheduler_type(const char *name)
+{
+    for (SchedulerType type = 0; type < SCHEDULER_UNDEF; ++type) {
+        if (strcmp(name, types[type].name) == 0) {
+            return type;
+        }
+    }
+    return SCHEDULER_UNDEF;
+}
@@ -0,0 +1,76 @@
+#include <error.h>
+#include <heap.h>
+#include <engine.h>
+
+typedef struct Sjf
+{
+    Heap *ready;
+    size_t order; // jobs made ready so far
+} Sjf;
+
+static void init(Engine *engine)
+{
+    Sjf *policy = amalloc(sizeof(Sjf));
+    policy->ready = heap_new();
+    policy->order = 0;
+    engine->policy = policy;
+}
+
+static void destroy(Engine *engine)
+{
+    Sjf *policy = engine->policy;
+    heap_destroy(policy->ready);
+    free(policy);
+}
+
+/**
+ * Ready jobs wait on a min-heap ordered by remaining burst, favouring the job
+ * that became ready first among ties. A job keeps its place in that order
+ * when preempted, just as it keeps its place among the engine's ready jobs.
+ */
+static void on_arrival(Engine *engine, Job *job)
+{
+    Sjf *policy = engine->policy;
+    job->slot = policy->order++;
+    heap_push(policy->ready, job->burst, job->slot, job);
+}
+
+/**
+ * The running job is preempted as soon as a shorter job becomes ready.
+ */
+static bool on_event(Engine *engine, Job *running)
+{
+    Sjf *policy = engine->policy;
+    ulong burst;
+    size_t slot;
+    heap_peek(policy->ready, &burst, &slot);
+    return burst < running->burst
+        || (burst == running->burst && slot < running->slot);
+}
+
+static void on_preempt(Engine *engine, Job *job)
+{
+    Sjf *policy = engine->policy;
+    heap_push(policy->ready, job->burst, job->slot, job);
+}
+
+static Job *pick_next(Engine *engine, Job *previous)
+{
+    Sjf *policy = engine->policy;
+    return heap_pop(policy->ready);
+}
+
+static void run(Engine *engine);
+
+const Policy policy_sjf = {
+    .title = "Shortest Job First (Pre)",
+    .init = init,
+    .destroy = destroy,
+    .on_arrival = on_arrival,
+    .on_event = on_event,
+    .on_preempt = on_preempt,
+    .pick_next = pick_next,
+    .run = run
+};
+
+ENGINE_SPECIALISE(run, policy_sjf)
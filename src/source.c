@@ -0,0 +1,232 @@
+#include <string.h>
+#include <error.h>
+#include <read.h>
+#include <source.h>
+
+typedef struct
+{
+    Process *process;
+    size_t index; // position within the list
+    size_t seq;   // position in order of arrival among every process
+} Entry;
+
+struct Source
+{
+    size_t count;
+    size_t consumed;
+
+    // Preloaded processes, sorted by arrival
+    Entry *entries;
+    uint group; // group of every process, if split off another source
+
+    // On demand processes
+    FILE *stream;
+    const char *filepath;
+    Process *next;
+    uint last;
+};
+
+static int cmp_arrival(const void *arg1, const void *arg2)
+{
+    const Entry *entry1 = arg1;
+    const Entry *entry2 = arg2;
+    uint arrival1 = process_arrival(entry1->process);
+    uint arrival2 = process_arrival(entry2->process);
+    if (arrival1 != arrival2) {
+        return arrival1 < arrival2 ? -1 : 1;
+    }
+    if (entry1->index != entry2->index) {
+        return entry1->index < entry2->index ? -1 : 1;
+    }
+    return 0;
+}
+
+Source *source_list(ProcessList *processes)
+{
+    Source *source = acalloc(1, sizeof(Source));
+    source->count = processlist_size(processes);
+    source->entries = acalloc(source->count, sizeof(Entry));
+    for (size_t i = 0; i < source->count; ++i) {
+        source->entries[i] = (Entry) {
+            .process = processlist_get(processes, i),
+            .index = i
+        };
+    }
+    qsort(source->entries, source->count, sizeof(Entry), cmp_arrival);
+    for (size_t i = 0; i < source->count; ++i) {
+        source->entries[i].seq = i;
+    }
+    return source;
+}
+
+static int cmp_group(const void *arg1, const void *arg2)
+{
+    const Entry *entry1 = arg1;
+    const Entry *entry2 = arg2;
+    uint group1 = process_group(entry1->process);
+    uint group2 = process_group(entry2->process);
+    if (group1 != group2) {
+        return group1 < group2 ? -1 : 1;
+    }
+    if (entry1->seq != entry2->seq) {
+        return entry1->seq < entry2->seq ? -1 : 1;
+    }
+    return 0;
+}
+
+Source **source_split(Source *source, size_t *count)
+{
+    if (source->stream) {
+        return NULL;
+    }
+    size_t i = 1;
+    while (i < source->count && process_group(source->entries[i].process)
+        == process_group(source->entries[0].process)) {
+        ++i;
+    }
+    if (i >= source->count) {
+        return NULL;
+    }
+
+    Entry *entries = amalloc(source->count * sizeof(Entry));
+    memcpy(entries, source->entries, source->count * sizeof(Entry));
+    qsort(entries, source->count, sizeof(Entry), cmp_group);
+
+    Source **parts = NULL;
+    *count = 0;
+    for (size_t first = 0, last; first < source->count; first = last) {
+        uint group = process_group(entries[first].process);
+        last = first + 1;
+        while (last < source->count
+            && process_group(entries[last].process) == group) {
+            ++last;
+        }
+        Source *part = acalloc(1, sizeof(Source));
+        part->group = group;
+        part->count = last - first;
+        part->entries = amalloc(part->count * sizeof(Entry));
+        memcpy(part->entries, entries + first, part->count * sizeof(Entry));
+        parts = realloc(parts, (*count + 1) * sizeof(Source *));
+        if (!parts) {
+            error_abort("memory allocation failure");
+        }
+        parts[(*count)++] = part;
+    }
+    free(entries);
+    return parts;
+}
+
+Source *source_stream(FILE *stream, size_t count, const char *filepath)
+{
+    Source *source = acalloc(1, sizeof(Source));
+    source->count = count;
+    source->stream = stream;
+    source->filepath = filepath;
+    if (count == 0 && !read_end(stream)) {
+        error_exit("line %lu in %s", lineno, filepath);
+    }
+    return source;
+}
+
+void source_destroy(Source *source)
+{
+    if (!source) {
+        return;
+    }
+    if (source->stream) {
+        process_destroy(source->next);
+    }
+    free(source->entries);
+    free(source);
+}
+
+size_t source_count(Source *source)
+{
+    return source->count;
+}
+
+uint source_group(Source *source)
+{
+    return source->group;
+}
+
+bool source_lazy(Source *source)
+{
+    return source->stream != NULL;
+}
+
+/**
+ * Makes sure the next on demand process has been parsed, verifying that the
+ * stream is sorted by arrival and properly terminated.
+ */
+static void stream_fill(Source *source)
+{
+    if (source->next || source->consumed == source->count) {
+        return;
+    }
+    if (!read_process(&source->next, source->stream)) {
+        error_exit("line %lu in %s", lineno, source->filepath);
+    }
+    if (process_group(source->next) != 0) {
+        error_exit("line %lu in %s: groups can't be streamed", lineno - 1,
+            source->filepath);
+    }
+    uint arrival = process_arrival(source->next);
+    if (source->consumed > 0 && arrival < source->last) {
+        error_exit("line %lu in %s: arrival out of order", lineno - 1,
+            source->filepath);
+    }
+    source->last = arrival;
+    if (source->consumed + 1 == source->count && !read_end(source->stream)) {
+        error_exit("line %lu in %s", lineno, source->filepath);
+    }
+}
+
+bool source_peek(Source *source, uint *arrival)
+{
+    if (source->stream) {
+        stream_fill(source);
+        if (!source->next) {
+            return false;
+        }
+        *arrival = process_arrival(source->next);
+        return true;
+    }
+    if (source->consumed == source->count) {
+        return false;
+    }
+    *arrival = process_arrival(source->entries[source->consumed].process);
+    return true;
+}
+
+size_t source_seq(Source *source)
+{
+    if (source->stream || source->consumed == source->count) {
+        return source->consumed;
+    }
+    return source->entries[source->consumed].seq;
+}
+
+Process *source_next(Source *source)
+{
+    if (source->stream) {
+        stream_fill(source);
+        Process *process = source->next;
+        if (process) {
+            source->next = NULL;
+            ++source->consumed;
+        }
+        return process;
+    }
+    if (source->consumed == source->count) {
+        return NULL;
+    }
+    return source->entries[source->consumed++].process;
+}
+
+void source_release(Source *source, Process *process)
+{
+    if (source->stream) {
+        process_destroy(process);
+    }
+}
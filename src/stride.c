@@ -0,0 +1,81 @@
+#include <error.h>
+#include <heap.h>
+#include <engine.h>
+
+/**
+ * The pass a job advances by for every quantum it runs is this constant
+ * divided by its tickets, so jobs run in proportion to their tickets. It is
+ * large enough that even UINT_MAX tickets make for a stride of at least 1,
+ * and small enough that passes can't overflow within UINT_MAX quanta.
+ */
+#define STRIDE_ONE (1UL << 32)
+
+typedef struct Stride
+{
+    Heap *ready;
+    ulong pass; // pass of the job dispatched last
+} Stride;
+
+static ulong stride(Job *job)
+{
+    return STRIDE_ONE / process_tickets(job->process);
+}
+
+static void init(Engine *engine)
+{
+    Stride *policy = amalloc(sizeof(Stride));
+    policy->ready = heap_new();
+    policy->pass = 0;
+    engine->policy = policy;
+}
+
+static void destroy(Engine *engine)
+{
+    Stride *policy = engine->policy;
+    heap_destroy(policy->ready);
+    free(policy);
+}
+
+/**
+ * Ready jobs wait on a min-heap ordered by pass, with the earliest arrival
+ * first among ties. A new job starts at the pass of the job dispatched last,
+ * so it can neither starve the others nor be starved by them.
+ */
+static void on_arrival(Engine *engine, Job *job)
+{
+    Stride *policy = engine->policy;
+    job->key = policy->pass;
+    heap_push(policy->ready, job->key, job->seq, job);
+}
+
+/**
+ * Once a job's quantum expires, its pass advances by its stride.
+ */
+static void on_preempt(Engine *engine, Job *job)
+{
+    Stride *policy = engine->policy;
+    job->key += stride(job);
+    heap_push(policy->ready, job->key, job->seq, job);
+}
+
+static Job *pick_next(Engine *engine, Job *previous)
+{
+    Stride *policy = engine->policy;
+    heap_peek(policy->ready, &policy->pass, NULL);
+    return heap_pop(policy->ready);
+}
+
+static void run(Engine *engine);
+
+const Policy policy_stride = {
+    .title = "Stride",
+    .init = init,
+    .destroy = destroy,
+    .on_arrival = on_arrival,
+    .on_preempt = on_preempt,
+    .pick_next = pick_next,
+    .slice = engine_quantum_slice,
+    .run = run
+};
+
+ENGINE_SPECIALISE(run, policy_stride)
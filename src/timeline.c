@@ -0,0 +1,239 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <error.h>
+#include <process.h>
+#include <timeline.h>
+
+/**
+ * The size of the buffer of each track's spool.
+ */
+#define TRACK_BUFFER (1 << 16)
+
+struct Track
+{
+    Timeline *timeline;
+    uint group;
+    FILE *spool;
+    char *buffer;
+    uint64_t count;          // segments recorded, including the last one
+    TimelineSegment last;    // held back in case it is extended
+    uint64_t base;           // index of the first segment within the index
+};
+
+struct Timeline
+{
+    size_t count;    // jobs, being one past the last job seen
+    size_t capacity; // jobs there is room for
+    TimelineJob *jobs;
+    Track **owners; // track each job's segments were recorded to
+    Track **tracks;
+    size_t ntracks;
+};
+
+Timeline *timeline_new(size_t count)
+{
+    Timeline *timeline = acalloc(1, sizeof(Timeline));
+    timeline->count = count;
+    timeline->capacity = count;
+    timeline->jobs = acalloc(count, sizeof(TimelineJob));
+    timeline->owners = acalloc(count, sizeof(Track *));
+    return timeline;
+}
+
+/**
+ * Makes room for a job beyond those the timeline was created for, doubling
+ * the room as needed, and counts it.
+ */
+static void grow(Timeline *timeline, size_t seq)
+{
+    if (seq >= timeline->capacity) {
+        size_t capacity = timeline->capacity ? timeline->capacity : 1024;
+        while (capacity <= seq) {
+            capacity *= 2;
+        }
+        timeline->jobs = realloc(timeline->jobs,
+            capacity * sizeof(TimelineJob));
+        timeline->owners = realloc(timeline->owners,
+            capacity * sizeof(Track *));
+        if (!timeline->jobs || !timeline->owners) {
+            error_abort("memory allocation failure");
+        }
+        size_t added = capacity - timeline->capacity;
+        memset(timeline->jobs + timeline->capacity, 0,
+            added * sizeof(TimelineJob));
+        memset(timeline->owners + timeline->capacity, 0,
+            added * sizeof(Track *));
+        timeline->capacity = capacity;
+    }
+    timeline->count = seq + 1;
+}
+
+void timeline_destroy(Timeline *timeline)
+{
+    if (!timeline) {
+        return;
+    }
+    for (size_t i = 0; i < timeline->ntracks; ++i) {
+        fclose(timeline->tracks[i]->spool);
+        free(timeline->tracks[i]->buffer);
+        free(timeline->tracks[i]);
+    }
+    free(timeline->tracks);
+    free(timeline->owners);
+    free(timeline->jobs);
+    free(timeline);
+}
+
+Track *timeline_track(Timeline *timeline, uint group)
+{
+    Track *track = acalloc(1, sizeof(Track));
+    track->timeline = timeline;
+    track->group = group;
+    track->spool = tmpfile();
+    if (!track->spool) {
+        error_exit("couldn't create timeline spool");
+    }
+    track->buffer = amalloc(TRACK_BUFFER);
+    setvbuf(track->spool, track->buffer, _IOFBF, TRACK_BUFFER);
+
+    timeline->tracks = realloc(timeline->tracks,
+        (timeline->ntracks + 1) * sizeof(Track *));
+    if (!timeline->tracks) {
+        error_abort("memory allocation failure");
+    }
+    timeline->tracks[timeline->ntracks++] = track;
+    return track;
+}
+
+void track_name(Track *track, size_t seq, const char *name)
+{
+    if (seq >= track->timeline->count) {
+        grow(track->timeline, seq);
+    }
+    strncpy(track->timeline->jobs[seq].name, name, PROCESS_NAME_MAX);
+}
+
+static void spool_segment(Track *track, const TimelineSegment *segment)
+{
+    if (fwrite(segment, sizeof(TimelineSegment), 1, track->spool) != 1) {
+        error_exit("couldn't write timeline spool");
+    }
+}
+
+void track_add(Track *track, size_t seq, uint start, uint end)
+{
+    if (track->count > 0 && track->last.seq == seq
+        && track->last.end == start) {
+        track->last.end = end;
+        return;
+    }
+    if (track->count > 0) {
+        spool_segment(track, &track->last);
+    }
+    if (seq >= track->timeline->count) {
+        grow(track->timeline, seq);
+    }
+    TimelineJob *job = &track->timeline->jobs[seq];
+    track->last = (TimelineSegment) {
+        .start = start,
+        .end = end,
+        .seq = seq,
+        .prev = job->count ? job->last : TIMELINE_NONE
+    };
+    job->last = track->count++;
+    ++job->count;
+    track->timeline->owners[seq] = track;
+}
+
+static int cmp_name(const void *arg1, const void *arg2, void *arg)
+{
+    const TimelineJob *jobs = arg;
+    uint64_t seq1 = *(const uint64_t *) arg1;
+    uint64_t seq2 = *(const uint64_t *) arg2;
+    int cmp = strncmp(jobs[seq1].name, jobs[seq2].name,
+        sizeof(jobs[seq1].name));
+    if (cmp != 0) {
+        return cmp;
+    }
+    return seq1 < seq2 ? -1 : seq1 > seq2 ? 1 : 0;
+}
+
+/**
+ * Copies the segments spooled by a track, turning the links between them
+ * into indices within the whole index.
+ */
+static void copy_track(Track *track, FILE *file)
+{
+    if (track->count > 0) {
+        spool_segment(track, &track->last);
+    }
+    rewind(track->spool);
+    TimelineSegment segment;
+    for (uint64_t i = 0; i < track->count; ++i) {
+        if (fread(&segment, sizeof(segment), 1, track->spool) != 1) {
+            error_exit("couldn't read timeline spool");
+        }
+        if (segment.prev != TIMELINE_NONE) {
+            segment.prev += track->base;
+        }
+        fwrite(&segment, sizeof(segment), 1, file);
+    }
+}
+
+bool timeline_write(Timeline *timeline, const char *filepath, uint runfor)
+{
+    FILE *file = fopen(filepath, "wb");
+    if (!file) {
+        return false;
+    }
+
+    uint64_t nsegments = 0;
+    for (size_t i = 0; i < timeline->ntracks; ++i) {
+        timeline->tracks[i]->base = nsegments;
+        nsegments += timeline->tracks[i]->count;
+    }
+    TimelineHeader header = {
+        .runfor = runfor,
+        .ntracks = timeline->ntracks,
+        .nsegments = nsegments,
+        .njobs = timeline->count,
+        .tracks = sizeof(TimelineHeader)
+    };
+    memcpy(header.magic, TIMELINE_MAGIC, sizeof(header.magic));
+    header.segments = header.tracks
+        + timeline->ntracks * sizeof(TimelineTrack);
+    header.jobs = header.segments + nsegments * sizeof(TimelineSegment);
+    header.names = header.jobs + timeline->count * sizeof(TimelineJob);
+    fwrite(&header, sizeof(header), 1, file);
+
+    for (size_t i = 0; i < timeline->ntracks; ++i) {
+        Track *track = timeline->tracks[i];
+        TimelineTrack entry = {
+            .group = track->group,
+            .first = track->base,
+            .count = track->count
+        };
+        fwrite(&entry, sizeof(entry), 1, file);
+    }
+    for (size_t i = 0; i < timeline->ntracks; ++i) {
+        copy_track(timeline->tracks[i], file);
+    }
+
+    uint64_t *names = amalloc(timeline->count * sizeof(uint64_t));
+    for (size_t i = 0; i < timeline->count; ++i) {
+        TimelineJob job = timeline->jobs[i];
+        if (job.count > 0) {
+            job.last += timeline->owners[i]->base;
+        }
+        fwrite(&job, sizeof(job), 1, file);
+        names[i] = i;
+    }
+    qsort_r(names, timeline->count, sizeof(uint64_t), cmp_name,
+        timeline->jobs);
+    fwrite(names, sizeof(uint64_t), timeline->count, file);
+    free(names);
+
+    bool written = !ferror(file);
+    return fclose(file) == 0 && written;
+}
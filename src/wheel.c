@@ -0,0 +1,153 @@
+#include <limits.h>
+#include <error.h>
+#include <wheel.h>
+
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_LEVELS ((sizeof(ulong) * CHAR_BIT + WHEEL_BITS - 1) / WHEEL_BITS)
+
+struct Wheel
+{
+    ulong now;
+    unsigned long long occupied[WHEEL_LEVELS];
+    Timer slots[WHEEL_LEVELS][WHEEL_SLOTS];
+};
+
+Wheel *wheel_new(ulong now)
+{
+    Wheel *wheel = amalloc(sizeof(Wheel));
+    wheel->now = now;
+    for (size_t level = 0; level < WHEEL_LEVELS; ++level) {
+        wheel->occupied[level] = 0;
+        for (size_t slot = 0; slot < WHEEL_SLOTS; ++slot) {
+            Timer *head = &wheel->slots[level][slot];
+            head->prev = head;
+            head->next = head;
+        }
+    }
+    return wheel;
+}
+
+void wheel_destroy(Wheel *wheel)
+{
+    free(wheel);
+}
+
+/**
+ * @return The first time at or after which the given slot is reached
+ */
+static ulong slot_start(ulong now, size_t level, size_t slot)
+{
+    size_t shift = WHEEL_BITS * (level + 1);
+    ulong base = shift < sizeof(ulong) * CHAR_BIT ? now >> shift << shift : 0;
+    return base | (ulong) slot << (WHEEL_BITS * level);
+}
+
+static void link_timer(Wheel *wheel, Timer *timer)
+{
+    ulong diff = timer->expiry ^ wheel->now;
+    size_t level = diff ? (sizeof(ulong) * CHAR_BIT - 1
+        - __builtin_clzl(diff)) / WHEEL_BITS : 0;
+    size_t slot = (timer->expiry >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1);
+    Timer *head = &wheel->slots[level][slot];
+
+    timer->level = level;
+    timer->slot = slot;
+    timer->prev = head->prev;
+    timer->next = head;
+    head->prev->next = timer;
+    head->prev = timer;
+    wheel->occupied[level] |= 1ULL << slot;
+}
+
+static void unlink_timer(Wheel *wheel, Timer *timer)
+{
+    timer->prev->next = timer->next;
+    timer->next->prev = timer->prev;
+    Timer *head = &wheel->slots[timer->level][timer->slot];
+    if (head->next == head) {
+        wheel->occupied[timer->level] &= ~(1ULL << timer->slot);
+    }
+    timer->prev = NULL;
+    timer->next = NULL;
+}
+
+void wheel_add(Wheel *wheel, Timer *timer, ulong expiry)
+{
+    if (expiry < wheel->now) {
+        error_abort("timer armed in the past");
+    }
+    timer->expiry = expiry;
+    link_timer(wheel, timer);
+}
+
+void wheel_cancel(Wheel *wheel, Timer *timer)
+{
+    unlink_timer(wheel, timer);
+}
+
+/**
+ * Moves the current time forward, cascading the timers of every slot the new
+ * time has entered into finer levels. Only the slot containing the new time
+ * needs cascading on each level, as every slot skipped over is empty.
+ */
+static void advance(Wheel *wheel, ulong now)
+{
+    ulong then = wheel->now;
+    wheel->now = now;
+    for (size_t level = WHEEL_LEVELS - 1; level > 0; --level) {
+        size_t shift = WHEEL_BITS * level;
+        if (then >> shift == now >> shift) {
+            continue;
+        }
+        size_t slot = (now >> shift) & (WHEEL_SLOTS - 1);
+        Timer *head = &wheel->slots[level][slot];
+        Timer *timer = head->next;
+        head->prev = head;
+        head->next = head;
+        wheel->occupied[level] &= ~(1ULL << slot);
+        while (timer != head) {
+            Timer *next = timer->next;
+            link_timer(wheel, timer);
+            timer = next;
+        }
+    }
+}
+
+bool wheel_next(Wheel *wheel, ulong *due)
+{
+    for (;;) {
+        if (wheel->occupied[0]) {
+            *due = slot_start(wheel->now, 0,
+                __builtin_ctzll(wheel->occupied[0]));
+            return true;
+        }
+        size_t level = 1;
+        while (level < WHEEL_LEVELS && !wheel->occupied[level]) {
+            ++level;
+        }
+        if (level == WHEEL_LEVELS) {
+            return false;
+        }
+        advance(wheel, slot_start(wheel->now, level,
+            __builtin_ctzll(wheel->occupied[level])));
+    }
+}
+
+Timer *wheel_expire(Wheel *wheel, ulong now)
+{
+    if (now < wheel->now) {
+        error_abort("wheel expired in the past");
+    }
+    if (now != wheel->now) {
+        advance(wheel, now);
+    }
+    size_t slot = now & (WHEEL_SLOTS - 1);
+    Timer *head = &wheel->slots[0][slot];
+    if (head->next == head) {
+        return NULL;
+    }
+    Timer *timer = head->next;
+    unlink_timer(wheel, timer);
+    return timer;
+}
@@ -2,13 +2,12 @@
 
 # Author: Kyle Martinez
 
-from filecmp import cmp
 from subprocess import Popen, call, PIPE, DEVNULL
 from shutil import copy
 import os
 import sys
 
-NUM_TESTCASES = 5
+NUM_TESTCASES = 15
 
 print("======================================================================")
 print("COMPILING")
@@ -30,25 +29,210 @@ print("======================================================================")
 print("TESTING")
 print("======================================================================")
 
-early_exit = False
-passed = 0
-os.chdir("./tests")
-for i in range(1, NUM_TESTCASES + 1):
-    in_filename = "set{i}_process.in".format(i=i)
-    out_filename = "set{i}_processes.out".format(i=i)
+OUTPUT_FILENAME = "processes.out"
+TIMELINE_FILENAME = "processes.idx"
+PROGRESS_FILEPATH = "/dev/shm/process-scheduler.{pid}"
+
 
-    print("Running {test}:".format(test=in_filename))
+def run_scheduler(flags=[]):
+    """Runs the scheduler on processes.in, returning its exit status and
+    whether it left its progress behind in shared memory."""
+    process = Popen(["../bin/scheduler"] + flags, stdout=DEVNULL,
+                    stderr=DEVNULL)
+    status = process.wait()
+    leftover = os.path.exists(PROGRESS_FILEPATH.format(pid=process.pid))
+    return status, leftover
+
+
+def check(in_filename, expected, flags=[], preallocated=0):
+    """Runs the scheduler with the given flags on a set, and compares its
+    output with the expected text. If space was preallocated for the output,
+    also checks that whatever went unused was released."""
+    global passed, total, early_exit
+    print("Running {test}{with_flags}:".format(
+        test=in_filename,
+        with_flags=" with " + " ".join(flags) if flags else ""))
     copy(in_filename, "processes.in")
-    if call("../bin/scheduler", stdout=DEVNULL, stderr=DEVNULL) != 0:
+    status, leftover = run_scheduler(flags)
+    total += 1
+    if status != 0:
         print("✖ | Exit failure")
         early_exit = True
-    elif not cmp(out_filename, "processes.out"):
+    elif read(OUTPUT_FILENAME) != expected:
         print("✖ | Output mismatch")
+    elif leftover:
+        print("✖ | Progress left in shared memory")
+    elif preallocated and allocated(OUTPUT_FILENAME) >= preallocated:
+        print("✖ | Preallocated space left unused")
+    else:
+        print("✓ | Passed")
+        passed += 1
+
+
+def check_error(in_filename, message, flags=[]):
+    """Runs the scheduler with the given flags on a set it should reject, and
+    checks that it exits with an error containing the message."""
+    global passed, total
+    print("Running {test}{with_flags}, expecting an error:".format(
+        test=in_filename,
+        with_flags=" with " + " ".join(flags) if flags else ""))
+    copy(in_filename, "processes.in")
+    process = Popen(["../bin/scheduler"] + flags, stdout=DEVNULL,
+                    stderr=PIPE, universal_newlines=True)
+    stderr = process.communicate()[1]
+    total += 1
+    if process.returncode == 0:
+        print("✖ | Exit success")
+    elif message not in stderr:
+        print("✖ | Unexpected error: " + stderr.strip())
+    else:
+        print("✓ | Passed")
+        passed += 1
+
+
+def check_timeline(in_filename, queries):
+    """Runs the scheduler on a set with a timeline, then checks the answers
+    bin/timeline gives to each query."""
+    global passed, total, early_exit
+    print("Running {test} with -t:".format(test=in_filename))
+    copy(in_filename, "processes.in")
+    status, _ = run_scheduler(["-t", TIMELINE_FILENAME])
+    total += 1
+    if status != 0:
+        print("✖ | Exit failure")
+        early_exit = True
+        return
+    for query, expected in queries:
+        process = Popen(["../bin/timeline", TIMELINE_FILENAME] + query,
+                        stdout=PIPE, stderr=DEVNULL, universal_newlines=True)
+        stdout = process.communicate()[0]
+        if process.returncode != 0 or stdout != expected:
+            print("✖ | Query mismatch: " + " ".join(query))
+            return
+    print("✓ | Passed")
+    passed += 1
+
+
+def check_generate(flags):
+    """Generates a workload twice with the same flags, checking that it comes
+    out the same, and that the scheduler can stream it."""
+    global passed, total, early_exit
+    print("Generating with {flags}:".format(flags=" ".join(flags)))
+    workloads = []
+    for _ in range(2):
+        process = Popen(["../bin/generate"] + flags, stdout=PIPE,
+                        stderr=DEVNULL, universal_newlines=True)
+        workloads.append(process.communicate()[0])
+        if process.returncode != 0:
+            break
+    total += 1
+    if process.returncode != 0:
+        print("✖ | Exit failure")
+        early_exit = True
+        return
+    if workloads[0] != workloads[1]:
+        print("✖ | Workload differs between runs")
+        return
+    with open("processes.in", "w") as file:
+        file.write(workloads[0])
+    status, _ = run_scheduler()
+    if status != 0:
+        print("✖ | Exit failure")
+        early_exit = True
+        return
+    expected = read(OUTPUT_FILENAME)
+    status, leftover = run_scheduler(["-s"])
+    if status != 0:
+        print("✖ | Exit failure with -s")
+        early_exit = True
+    elif read(OUTPUT_FILENAME) != expected:
+        print("✖ | Output mismatch with -s")
+    elif leftover:
+        print("✖ | Progress left in shared memory")
     else:
         print("✓ | Passed")
         passed += 1
 
-cleanup = ["processes.in", "processes.out"]
+
+def read(filename):
+    with open(filename) as file:
+        return file.read()
+
+
+def allocated(filename):
+    """The space a file takes up on disk, which may exceed its size."""
+    return os.stat(filename).st_blocks * 512
+
+
+def streamable(in_filename):
+    """True if a set lists its processes in order of arrival, without any
+    groups, so that it can be streamed."""
+    arrivals = []
+    for line in read(in_filename).splitlines():
+        words = line.split("#")[0].split()
+        if words[:1] == ["process"]:
+            if "group" in words:
+                return False
+            arrivals.append(int(words[words.index("arrival") + 1]))
+    return arrivals == sorted(arrivals)
+
+
+early_exit = False
+passed = 0
+total = 0
+os.chdir("./tests")
+for i in range(1, NUM_TESTCASES + 1):
+    in_filename = "set{i}_process.in".format(i=i)
+    out_filename = "set{i}_processes.out".format(i=i)
+    check(in_filename, read(out_filename))
+
+# Streaming must not change the output of sets that can be streamed
+for i in range(1, NUM_TESTCASES + 1):
+    in_filename = "set{i}_process.in".format(i=i)
+    out_filename = "set{i}_processes.out".format(i=i)
+    if streamable(in_filename):
+        check(in_filename, read(out_filename), ["-s"])
+check_error("unsorted_process.in", "line 5 in processes.in", ["-s"])
+
+# An I/O burst can't follow an empty first burst, with or without streaming
+check_error("zero_burst_io_process.in", "line 4 in processes.in")
+check_error("zero_burst_io_process.in", "line 4 in processes.in", ["-s"])
+
+# Buffering must not change the output, even across many buffer boundaries
+check("set14_process.in", read("set14_processes.out"), ["-a", "-b", "4K"])
+check("set14_process.in", read("set14_processes.out"), ["-d", "-p", "1M"],
+      preallocated=1 << 20)
+
+# The timeline answers queries about when processes ran
+check_timeline("set10_process.in", [
+    (["at", "0"], "Time 0: P1 running (0 to 2)\n"),
+    (["at", "7"], "Time 7: P2 running (7 to 9)\n"),
+    (["at", "40"], "Time 40: nothing running\n"),
+    (["job", "P2"], "P2 ran from 2 to 4\n"
+                    "P2 ran from 7 to 9\n"
+                    "P2 ran from 14 to 17\n"
+                    "P2 ran from 18 to 19\n"
+                    "P2 ran for 8 ticks in 4 segments\n")
+])
+check_timeline("set8_process.in", [
+    (["at", "5"], "Time 5: group 1 P1 running (4 to 6)\n"
+                  "Time 5: group 2 P2 running (5 to 6)\n")
+])
+
+# Generated workloads are reproducible, and can always be streamed
+check_generate(["-n", "2000", "-u", "sjf", "-s", "7"])
+check_generate(["-n", "2000", "-u", "stride", "-q", "3", "-s", "7",
+                "-a", "onoff", "-b", "pareto:8,1.5"])
+
+# Metrics only drops the event log, and nothing else
+for i in range(1, NUM_TESTCASES + 1):
+    in_filename = "set{i}_process.in".format(i=i)
+    out_filename = "set{i}_processes.out".format(i=i)
+    lines = read(out_filename).splitlines(True)
+    check(in_filename, "".join(line for line in lines
+                               if not line.startswith("Time ")), ["-m"])
+
+cleanup = ["processes.in", "processes.out", "processes.idx"]
 for filename in cleanup:
     try:
         os.remove(filename)
@@ -58,7 +242,7 @@ for filename in cleanup:
 print("======================================================================")
 print("RESULTS")
 print("======================================================================")
-print("Tests Passed = {p} / {t}".format(p=passed, t=NUM_TESTCASES))
+print("Tests Passed = {p} / {t}".format(p=passed, t=total))
 if early_exit:
     print("Advice: run `make debug` and use gdb or lldb to diagnose failures")
 print("======================================================================")
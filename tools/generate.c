@@ -0,0 +1,346 @@
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <error.h>
+#include <random.h>
+#include <schedulertype.h>
+
+#define USAGE ("usage: %s [-n count] [-r runfor] [-u policy] [-q quantum] " \
+    "[-s seed] [-a arrivals] [-b bursts]")
+
+/**
+ * The size of the buffer the workload is streamed through.
+ */
+#define GENERATE_BUFFER (1 << 20)
+
+#define PARAMS_MAX 3
+
+// #region Distributions -------------------------------------------------------
+
+typedef enum
+{
+    ARRIVALS_POISSON,
+    ARRIVALS_ONOFF
+} Arrivals;
+
+typedef enum
+{
+    BURSTS_EXP,
+    BURSTS_PARETO,
+    BURSTS_BIMODAL
+} Bursts;
+
+typedef struct
+{
+    const char *name;
+    int kind;
+    int nparams;
+    double params[PARAMS_MAX]; // defaults, overridden in order
+} Distribution;
+
+/**
+ * poisson:GAP       Arrivals GAP ticks apart on average
+ * onoff:GAP,ON,OFF  Poisson arrivals during on periods ON ticks long on
+ *                   average, separated by silent periods OFF ticks long on
+ *                   average
+ */
+static const Distribution arrivals[] = {
+    { "poisson", ARRIVALS_POISSON, 1, { 4 } },
+    { "onoff", ARRIVALS_ONOFF, 3, { 1, 100, 400 } }
+};
+
+/**
+ * exp:MEAN                   Exponential bursts
+ * pareto:MEAN,SHAPE          Heavy-tailed bursts, SHAPE being above 1
+ * bimodal:SHORT,LONG,CHANCE  Exponential bursts SHORT ticks long on average,
+ *                            or LONG ticks long with the given chance
+ */
+static const Distribution bursts[] = {
+    { "exp", BURSTS_EXP, 1, { 4 } },
+    { "pareto", BURSTS_PARETO, 2, { 4, 1.5 } },
+    { "bimodal", BURSTS_BIMODAL, 3, { 2, 50, 0.1 } }
+};
+
+#define countof(array) (sizeof(array) / sizeof(array[0]))
+
+/**
+ * Parses a distribution written as NAME or NAME:PARAM,PARAM,...
+ *
+ * @return False if the name isn't known or the parameters are malformed
+ */
+static bool get_distribution(Distribution *dest, const Distribution *known,
+    size_t count, const char *str)
+{
+    size_t length = strcspn(str, ":");
+    for (size_t i = 0; i < count; ++i) {
+        if (strlen(known[i].name) != length
+            || strncmp(known[i].name, str, length) != 0) {
+            continue;
+        }
+        *dest = known[i];
+        if (!str[length]) {
+            return true;
+        }
+        const char *param = str + length + 1;
+        for (int j = 0; j < dest->nparams; ++j) {
+            char *end;
+            dest->params[j] = strtod(param, &end);
+            if (end == param || !(dest->params[j] > 0)) {
+                return false;
+            }
+            if (!*end) {
+                return true;
+            }
+            if (*end != ',') {
+                return false;
+            }
+            param = end + 1;
+        }
+        return false;
+    }
+    return false;
+}
+
+/**
+ * @return A uniformly distributed real within (0, 1)
+ */
+static double uniform(Random *random)
+{
+    return ((random_next(random) >> 11) + 0.5) * 0x1p-53;
+}
+
+static double exponential(Random *random, double mean)
+{
+    return -mean * log(uniform(random));
+}
+
+/**
+ * Advances the time of the next arrival.
+ */
+typedef struct
+{
+    const Distribution *dist;
+    double now;
+    double until; // end of the current on period
+} Clock;
+
+static double clock_next(Clock *clock, Random *random)
+{
+    const double *params = clock->dist->params;
+    clock->now += exponential(random, params[0]);
+    if (clock->dist->kind == ARRIVALS_ONOFF) {
+        // Whatever is left of the gap carries over into the next on period
+        while (clock->now >= clock->until) {
+            double off = exponential(random, params[2]);
+            clock->now += off;
+            clock->until += off + exponential(random, params[1]);
+        }
+    }
+    return clock->now;
+}
+
+static double burst_next(const Distribution *dist, Random *random)
+{
+    const double *params = dist->params;
+    switch (dist->kind) {
+        case BURSTS_PARETO: {
+            double shape = params[1];
+            double scale = params[0] * (shape - 1) / shape;
+            return scale / pow(uniform(random), 1 / shape);
+        }
+        case BURSTS_BIMODAL:
+            if (uniform(random) < params[2]) {
+                return exponential(random, params[1]);
+            }
+            return exponential(random, params[0]);
+        default:
+            return exponential(random, params[0]);
+    }
+}
+
+/**
+ * @return The mean of a burst distribution, used to size the default runfor
+ */
+static double burst_mean(const Distribution *dist)
+{
+    const double *params = dist->params;
+    if (dist->kind == BURSTS_BIMODAL) {
+        return params[0] * (1 - params[2]) + params[1] * params[2];
+    }
+    return params[0];
+}
+
+/**
+ * @return The mean time between arrivals, used to size the default runfor
+ */
+static double arrival_gap(const Distribution *dist)
+{
+    const double *params = dist->params;
+    if (dist->kind == ARRIVALS_ONOFF) {
+        return params[0] * (params[1] + params[2]) / params[1];
+    }
+    return params[0];
+}
+
+// #endregion ------------------------------------------------------------------
+
+// #region Main ----------------------------------------------------------------
+
+/**
+ * Parses a count, optionally suffixed with K, M or G (powers of 1000).
+ */
+static unsigned long long get_count(const char *str, const char *program)
+{
+    char *end;
+    unsigned long long count = strtoull(str, &end, 10);
+    switch (*end) {
+        case 'G':
+            count *= 1000; // fall through
+        case 'M':
+            count *= 1000; // fall through
+        case 'K':
+            count *= 1000;
+            ++end;
+            break;
+    }
+    if (end == str || *end) {
+        error_exit(USAGE, program);
+    }
+    return count;
+}
+
+/**
+ * @return A time rounded down to a whole tick, saturating at UINT_MAX
+ */
+static uint to_tick(double time)
+{
+    return time < UINT_MAX ? (uint) time : UINT_MAX;
+}
+
+/**
+ * Formats an unsigned integer into the end of a buffer.
+ *
+ * @return A pointer to the first digit
+ */
+static char *format_uint(char *end, unsigned long long value)
+{
+    do {
+        *--end = '0' + value % 10;
+        value /= 10;
+    }
+    while (value > 0);
+    return end;
+}
+
+static void put_uint(unsigned long long value)
+{
+    char digits[20];
+    char *end = digits + sizeof(digits);
+    char *start = format_uint(end, value);
+    fwrite(start, 1, end - start, stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long long count = 1000;
+    unsigned long long runfor = 0;
+    SchedulerType use = SCHEDULER_FCFS;
+    unsigned long long quantum = 2;
+    unsigned long long seed = 1;
+    Distribution arrival = arrivals[ARRIVALS_POISSON];
+    Distribution burst = bursts[BURSTS_EXP];
+    int opt;
+    while ((opt = getopt(argc, argv, "n:r:u:q:s:a:b:")) != -1) {
+        switch (opt) {
+            case 'n':
+                count = get_count(optarg, argv[0]);
+                break;
+            case 'r':
+                runfor = get_count(optarg, argv[0]);
+                break;
+            case 'u':
+                use = scheduler_type(optarg);
+                if (use == SCHEDULER_UNDEF) {
+                    error_exit("unknown policy %s", optarg);
+                }
+                break;
+            case 'q':
+                quantum = get_count(optarg, argv[0]);
+                break;
+            case 's':
+                seed = get_count(optarg, argv[0]);
+                break;
+            case 'a':
+                if (!get_distribution(&arrival, arrivals, countof(arrivals),
+                    optarg)) {
+                    error_exit("unknown arrivals %s", optarg);
+                }
+                break;
+            case 'b':
+                if (!get_distribution(&burst, bursts, countof(bursts),
+                    optarg)) {
+                    error_exit("unknown bursts %s", optarg);
+                }
+                break;
+            default:
+                error_exit(USAGE, argv[0]);
+        }
+    }
+    if (optind != argc) {
+        error_exit(USAGE, argv[0]);
+    }
+    if (burst.kind == BURSTS_PARETO && burst.params[1] <= 1) {
+        error_exit("pareto shape must be above 1");
+    }
+    if (burst.kind == BURSTS_BIMODAL && burst.params[2] >= 1) {
+        error_exit("bimodal chance must be below 1");
+    }
+    if (runfor == 0) {
+        // Long enough for every process to arrive and, load permitting, finish
+        runfor = to_tick(count * fmax(arrival_gap(&arrival),
+            burst_mean(&burst)) * 2);
+    }
+    if (runfor > UINT_MAX || quantum == 0 || quantum > UINT_MAX) {
+        error_exit(USAGE, argv[0]);
+    }
+
+    static char buffer[GENERATE_BUFFER];
+    setvbuf(stdout, buffer, _IOFBF, GENERATE_BUFFER);
+
+    printf("processcount %llu\nrunfor %llu\nuse %s\n", count, runfor,
+        scheduler_name(use));
+    if (scheduler_quantum(use)) {
+        printf("quantum %llu\n", quantum);
+    }
+
+    // Arrivals only ever increase, so the workload can be streamed back in
+    Random random;
+    random_seed(&random, seed);
+    Clock clock = { &arrival, 0, 0 };
+    if (arrival.kind == ARRIVALS_ONOFF) {
+        clock.until = exponential(&random, arrival.params[1]);
+    }
+    for (unsigned long long i = 1; i <= count; ++i) {
+        uint at = to_tick(clock_next(&clock, &random));
+        double length = burst_next(&burst, &random);
+        uint ticks = length < 1 ? 1 : to_tick(length + 0.5);
+        fputs("process name P", stdout);
+        put_uint(i);
+        fputs(" arrival ", stdout);
+        put_uint(at);
+        fputs(" burst ", stdout);
+        put_uint(ticks);
+        putchar('\n');
+    }
+    fputs("end\n", stdout);
+
+    if (fflush(stdout) != 0) {
+        error_exit("couldn't write workload");
+    }
+    exit(EXIT_SUCCESS);
+}
+
+// #endregion ------------------------------------------------------------------
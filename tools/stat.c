@@ -0,0 +1,200 @@
+#include <dirent.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <error.h>
+#include <progress.h>
+
+#define USAGE ("usage: %s [-w seconds] [pid]")
+
+/**
+ * The directory POSIX shared memory is found in.
+ */
+#define SHM_DIRECTORY ("/dev/shm")
+
+/**
+ * A copy of the counters of published progress, taken at one moment.
+ */
+typedef struct
+{
+    uint64_t runfor;
+    uint64_t cpus;
+    uint64_t processes;
+    uint64_t ticks;
+    uint64_t events;
+    uint64_t arrived;
+    uint64_t finished;
+    uint64_t written;
+    uint64_t done;
+} Sample;
+
+static Sample sample(const Progress *progress)
+{
+    return (Sample) {
+        .runfor = progress_load(&progress->runfor),
+        .cpus = progress_load(&progress->cpus),
+        .processes = progress_load(&progress->processes),
+        .ticks = progress_load(&progress->ticks),
+        .events = progress_load(&progress->events),
+        .arrived = progress_load(&progress->arrived),
+        .finished = progress_load(&progress->finished),
+        .written = progress_load(&progress->written),
+        .done = progress_load(&progress->done)
+    };
+}
+
+/**
+ * @return True if a process is still running
+ */
+static bool alive(pid_t pid)
+{
+    return kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+/**
+ * Prints a sample, along with how fast the simulation went since the previous
+ * sample and when it should finish at that pace, if there was one.
+ */
+static void print_sample(pid_t pid, const Sample *now, const Sample *before,
+    unsigned seconds)
+{
+    const char *state = now->done ? "done"
+        : alive(pid) ? "running" : "exited";
+    printf("Simulation %ld (%s)\n", (long) pid, state);
+
+    uint64_t cpus = now->cpus ? now->cpus : 1;
+    uint64_t capacity = now->runfor * cpus;
+    double percent = capacity ? 100.0 * now->ticks / capacity : 100.0;
+    printf("Time %llu of %llu", (unsigned long long) (now->ticks / cpus),
+        (unsigned long long) now->runfor);
+    if (cpus > 1) {
+        printf(" on each of %llu CPUs", (unsigned long long) cpus);
+    }
+    printf(" (%.2f%%)\n", percent);
+
+    printf("%llu events\n", (unsigned long long) now->events);
+    printf("%llu of %llu processes arrived, %llu finished\n",
+        (unsigned long long) now->arrived,
+        (unsigned long long) now->processes,
+        (unsigned long long) now->finished);
+    printf("%llu bytes written\n", (unsigned long long) now->written);
+
+    if (before && !now->done) {
+        double rate = (double) (now->ticks - before->ticks) / seconds;
+        printf("%.0f ticks per second", rate / cpus);
+        if (rate > 0) {
+            printf(", done in about %.0f seconds",
+                (capacity - now->ticks) / rate);
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * Reports on one simulation, every so many seconds until it ends if watching.
+ *
+ * @return False if the simulation hasn't published any progress
+ */
+static bool report(pid_t pid, unsigned seconds)
+{
+    if (!alive(pid)) {
+        // Killed before it could withdraw its progress
+        progress_remove(pid);
+        return false;
+    }
+    const Progress *progress = progress_attach(pid);
+    if (!progress) {
+        return false;
+    }
+    Sample now = sample(progress);
+    print_sample(pid, &now, NULL, seconds);
+    while (seconds > 0 && !now.done && alive(pid)) {
+        sleep(seconds);
+        Sample before = now;
+        now = sample(progress);
+        printf("\n");
+        print_sample(pid, &now, &before, seconds);
+        fflush(stdout);
+    }
+    progress_detach(progress);
+    if (!alive(pid)) {
+        progress_remove(pid);
+    }
+    return true;
+}
+
+/**
+ * Reports on every simulation that has published its progress.
+ *
+ * @return The number of simulations reported on
+ */
+static size_t report_all(unsigned seconds)
+{
+    DIR *dir = opendir(SHM_DIRECTORY);
+    if (!dir) {
+        error_exit("couldn't open %s", SHM_DIRECTORY);
+    }
+    size_t count = 0;
+    size_t length = strlen(PROGRESS_PREFIX);
+    struct dirent *entry;
+    while ((entry = readdir(dir))) {
+        if (strncmp(entry->d_name, PROGRESS_PREFIX, length) != 0) {
+            continue;
+        }
+        char *end;
+        long pid = strtol(entry->d_name + length, &end, 10);
+        if (end == entry->d_name + length || *end) {
+            continue;
+        }
+        if (!alive(pid)) {
+            progress_remove(pid);
+            continue;
+        }
+        if (count > 0) {
+            printf("\n");
+        }
+        count += report(pid, seconds);
+    }
+    closedir(dir);
+    return count;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned seconds = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "w:")) != -1) {
+        switch (opt) {
+            case 'w': {
+                char *end;
+                seconds = strtoul(optarg, &end, 10);
+                if (end == optarg || *end || seconds == 0) {
+                    error_exit(USAGE, argv[0]);
+                }
+                break;
+            }
+            default:
+                error_exit(USAGE, argv[0]);
+        }
+    }
+    if (optind + 1 < argc) {
+        error_exit(USAGE, argv[0]);
+    }
+    if (optind < argc) {
+        char *end;
+        long pid = strtol(argv[optind], &end, 10);
+        if (end == argv[optind] || *end || pid <= 0) {
+            error_exit(USAGE, argv[0]);
+        }
+        if (!report(pid, seconds)) {
+            error_exit("no simulation running as %ld", pid);
+        }
+    }
+    else if (report_all(seconds) == 0) {
+        error_exit("no simulations running");
+    }
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,181 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <error.h>
+#include <timeline.h>
+
+#define USAGE ("usage: %s timeline (at tick | job name)")
+
+typedef struct
+{
+    const TimelineHeader *header;
+    const TimelineTrack *tracks;
+    const TimelineSegment *segments;
+    const TimelineJob *jobs;
+    const uint64_t *names;
+} Index;
+
+/**
+ * Maps an index into memory, verifying that every table it points at lies
+ * within the file.
+ */
+static Index index_map(const char *filepath)
+{
+    int fd = open(filepath, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        error_exit("couldn't open %s", filepath);
+    }
+    size_t size = st.st_size;
+    if (size < sizeof(TimelineHeader)) {
+        error_exit("%s isn't a timeline", filepath);
+    }
+    const char *base = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        error_exit("couldn't map %s", filepath);
+    }
+
+    Index index = { .header = (const TimelineHeader *) base };
+    const TimelineHeader *header = index.header;
+    if (memcmp(header->magic, TIMELINE_MAGIC, sizeof(header->magic)) != 0
+        || header->tracks + header->ntracks * sizeof(TimelineTrack) > size
+        || header->segments + header->nsegments * sizeof(TimelineSegment)
+            > size
+        || header->jobs + header->njobs * sizeof(TimelineJob) > size
+        || header->names + header->njobs * sizeof(uint64_t) > size) {
+        error_exit("%s isn't a timeline", filepath);
+    }
+    index.tracks = (const TimelineTrack *) (base + header->tracks);
+    index.segments = (const TimelineSegment *) (base + header->segments);
+    index.jobs = (const TimelineJob *) (base + header->jobs);
+    index.names = (const uint64_t *) (base + header->names);
+    return index;
+}
+
+/**
+ * Finds the segment of a track running at a given time.
+ *
+ * @return The segment, or NULL if nothing was running
+ */
+static const TimelineSegment *track_at(const Index *index,
+    const TimelineTrack *track, uint32_t tick)
+{
+    // Find the first segment starting after the tick
+    const TimelineSegment *segments = index->segments + track->first;
+    uint64_t low = 0, high = track->count;
+    while (low < high) {
+        uint64_t mid = low + (high - low) / 2;
+        if (segments[mid].start <= tick) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    if (low == 0 || segments[low - 1].end <= tick) {
+        return NULL;
+    }
+    return &segments[low - 1];
+}
+
+static void query_at(const Index *index, uint32_t tick)
+{
+    uint32_t ntracks = index->header->ntracks;
+    for (uint32_t i = 0; i < ntracks; ++i) {
+        const TimelineSegment *segment = track_at(index, &index->tracks[i],
+            tick);
+        printf("Time %u: ", tick);
+        if (ntracks > 1) {
+            printf("group %u ", index->tracks[i].group);
+        }
+        if (segment) {
+            printf("%.*s running (%u to %u)\n",
+                (int) sizeof(index->jobs->name),
+                index->jobs[segment->seq].name, segment->start,
+                segment->end);
+        }
+        else {
+            printf("nothing running\n");
+        }
+    }
+}
+
+/**
+ * Finds a job by name.
+ *
+ * @return The position of the job in order of arrival, or UINT64_MAX if no
+ *         job goes by the name
+ */
+static uint64_t find_job(const Index *index, const char *name)
+{
+    size_t length = sizeof(index->jobs->name);
+    uint64_t low = 0, high = index->header->njobs;
+    while (low < high) {
+        uint64_t mid = low + (high - low) / 2;
+        if (strncmp(index->jobs[index->names[mid]].name, name, length) < 0) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    if (low == index->header->njobs
+        || strncmp(index->jobs[index->names[low]].name, name, length) != 0) {
+        return UINT64_MAX;
+    }
+    return index->names[low];
+}
+
+static void query_job(const Index *index, const char *name)
+{
+    uint64_t seq = find_job(index, name);
+    if (seq == UINT64_MAX) {
+        error_exit("no process named %s", name);
+    }
+    const TimelineJob *job = &index->jobs[seq];
+
+    // Segments are linked from last to first
+    uint64_t *order = acalloc(job->count, sizeof(uint64_t));
+    uint64_t count = 0;
+    uint64_t i = job->last;
+    while (count < job->count) {
+        order[count++] = i;
+        i = index->segments[i].prev;
+    }
+    uint64_t total = 0;
+    while (count > 0) {
+        const TimelineSegment *segment = &index->segments[order[--count]];
+        printf("%s ran from %u to %u\n", name, segment->start, segment->end);
+        total += segment->end - segment->start;
+    }
+    printf("%s ran for %llu ticks in %llu segments\n", name,
+        (unsigned long long) total, (unsigned long long) job->count);
+    free(order);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 4) {
+        error_exit(USAGE, argv[0]);
+    }
+    Index index = index_map(argv[1]);
+    if (strcmp(argv[2], "at") == 0) {
+        char *end;
+        unsigned long tick = strtoul(argv[3], &end, 10);
+        if (end == argv[3] || *end || tick > UINT32_MAX) {
+            error_exit(USAGE, argv[0]);
+        }
+        query_at(&index, tick);
+    }
+    else if (strcmp(argv[2], "job") == 0) {
+        query_job(&index, argv[3]);
+    }
+    else {
+        error_exit(USAGE, argv[0]);
+    }
+    exit(EXIT_SUCCESS);
+}